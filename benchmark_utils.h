@@ -0,0 +1,23 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <chrono>
+
+// Shared scaffolding of the *_benchmark.cpp drivers
+
+// Wall time of one call of function
+template <class Function>
+double MeasureSeconds(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// The compiler has to assume value is read here, so the work that computed it is not optimized away
+template <class T>
+void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif
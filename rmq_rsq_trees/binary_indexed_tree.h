@@ -0,0 +1,218 @@
+#ifndef RMQ_RSQ_TREES_BINARY_INDEXED_TREE_H
+#define RMQ_RSQ_TREES_BINARY_INDEXED_TREE_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Binary indexed tree over a kDimensions-dimensional box in one contiguous buffer.
+// Cell (x_0, ..., x_{k-1}) lives at x_0 + sizes[0] * (x_1 + sizes[1] * (...)), so the first
+// coordinate is the contiguous one; the nested loops over dimensions are unrolled at compile time.
+// Query takes an inclusive box and combines the 2^kDimensions prefix results by inclusion-exclusion
+// with Op and InverseOp, as the 2D and 3D trees did.
+template <class Element, class Op, class InverseOp, size_t kDimensions>
+class BinaryIndexedTree {
+public:
+    using Point = std::array<size_t, kDimensions>;
+
+    BinaryIndexedTree(const Point& sizes, const Element& neutral_element,
+                      const Op& oper = Op(), const InverseOp& inverse_oper = InverseOp())
+        : sizes_(sizes), oper_(oper), inverse_oper_(inverse_oper), neutral_element_(neutral_element) {
+        size_t total = 1;
+        for (size_t dim = 0; dim < kDimensions; ++dim) {
+            strides_[dim] = total;
+            total *= sizes_[dim];
+        }
+        tree_.assign(total, neutral_element_);
+    }
+
+    // values are laid out as the tree is. Every cell adds itself to its parent along one dimension
+    // at a time, O(size * kDimensions) instead of a logarithmic Update per cell; along all dimensions
+    // but the first the parent is a whole contiguous slab away, so those passes are plain vector loops.
+    BinaryIndexedTree(const Point& sizes, const std::vector<Element>& values, const Element& neutral_element,
+                      const Op& oper = Op(), const InverseOp& inverse_oper = InverseOp())
+        : BinaryIndexedTree(sizes, neutral_element, oper, inverse_oper) {
+        tree_ = values;
+        for (size_t dim = 0; dim < kDimensions; ++dim) {
+            const size_t inner = strides_[dim];
+            const size_t outer = tree_.size() / (inner * sizes_[dim]);
+            for (size_t block = 0; block < outer; ++block) {
+                Element* base = tree_.data() + block * inner * sizes_[dim];
+                for (size_t i = 0; i < sizes_[dim]; ++i) {
+                    const size_t parent = NextIncrement(i);
+                    if (parent >= sizes_[dim]) {
+                        continue;
+                    }
+                    Element* to = base + parent * inner;
+                    const Element* from = base + i * inner;
+                    for (size_t k = 0; k < inner; ++k) {
+                        to[k] = oper_(to[k], from[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    const Point& Sizes() const {
+        return sizes_;
+    }
+
+    void Update(const Point& point, const Element& delta) {
+        UpdateDimension<kDimensions - 1>(0, point, delta);
+    }
+
+    // Result over the box low <= point <= high
+    Element Query(const Point& low, const Point& high) const {
+        Element positive_impact = neutral_element_;
+        Element negative_impact = neutral_element_;
+        for (size_t corner = 0; corner < (size_t(1) << kDimensions); ++corner) {
+            Point end;
+            bool empty = false;
+            for (size_t dim = 0; dim < kDimensions; ++dim) {
+                end[dim] = (corner >> dim & 1) ? low[dim] : high[dim] + 1;
+                empty |= end[dim] == 0;
+            }
+            if (empty) {
+                continue;
+            }
+            if (__builtin_popcountll(corner) % 2 == 0) {
+                positive_impact = oper_(positive_impact, PrefixQuery(end));
+            } else {
+                negative_impact = oper_(negative_impact, PrefixQuery(end));
+            }
+        }
+        return inverse_oper_(positive_impact, negative_impact);
+    }
+
+    // Result over the box [0, end), every end[dim] > 0
+    Element PrefixQuery(const Point& end) const {
+        Element result = neutral_element_;
+        PrefixDimension<kDimensions - 1>(0, end, result);
+        return result;
+    }
+
+private:
+    Point sizes_;
+    Point strides_;
+    std::vector<Element> tree_;
+    const Op oper_;
+    const InverseOp inverse_oper_;
+    const Element neutral_element_;
+
+    static size_t NextIncrement(size_t idx) {
+        return idx | (idx + 1);
+    }
+
+    // With exclusive ends, end covers [end & (end - 1), end) and the next one to take is end & (end - 1)
+    static size_t NextDecrement(size_t end) {
+        return end & (end - 1);
+    }
+
+    template <size_t kDim>
+    void UpdateDimension(size_t offset, const Point& point, const Element& delta) {
+        for (size_t i = point[kDim]; i < sizes_[kDim]; i = NextIncrement(i)) {
+            if constexpr (kDim == 0) {
+                tree_[offset + i] = oper_(tree_[offset + i], delta);
+            } else {
+                UpdateDimension<kDim - 1>(offset + i * strides_[kDim], point, delta);
+            }
+        }
+    }
+
+    template <size_t kDim>
+    void PrefixDimension(size_t offset, const Point& end, Element& result) const {
+        for (size_t i = end[kDim]; i > 0; i = NextDecrement(i)) {
+            if constexpr (kDim == 0) {
+                result = oper_(result, tree_[offset + i - 1]);
+            } else {
+                PrefixDimension<kDim - 1>(offset + (i - 1) * strides_[kDim], end, result);
+            }
+        }
+    }
+};
+
+template <class Element, class Op, class InverseOp>
+using BinaryIndexedTree2D = BinaryIndexedTree<Element, Op, InverseOp, 2>;
+
+template <class Element, class Op, class InverseOp>
+using BinaryIndexedTree3D = BinaryIndexedTree<Element, Op, InverseOp, 3>;
+
+// Range add and range sum over a box for arithmetic Element. With d the difference array of
+// the updates, the sum over [0, end) is the sum over cells j < end of d[j] * prod(end[dim] - j[dim]).
+// Expanding the product gives one tree per subset S of dimensions storing d[j] * prod_{dim in S} j[dim],
+// so there are 2^kDimensions trees and an update adds to 2^kDimensions corners of each.
+template <class Element, size_t kDimensions>
+class RangeBinaryIndexedTree {
+public:
+    using Tree = BinaryIndexedTree<Element, std::plus<Element>, std::minus<Element>, kDimensions>;
+    using Point = typename Tree::Point;
+
+    explicit RangeBinaryIndexedTree(const Point& sizes)
+        : sizes_(sizes), trees_(size_t(1) << kDimensions, Tree(sizes, Element())) {
+    }
+
+    // Adds delta to every cell of the box low <= point <= high
+    void Update(const Point& low, const Point& high, const Element& delta) {
+        for (size_t corner = 0; corner < (size_t(1) << kDimensions); ++corner) {
+            Point point;
+            bool outside = false;
+            for (size_t dim = 0; dim < kDimensions; ++dim) {
+                point[dim] = (corner >> dim & 1) ? high[dim] + 1 : low[dim];
+                outside |= point[dim] >= sizes_[dim];
+            }
+            if (outside) {
+                continue;
+            }
+            const Element signed_delta = __builtin_popcountll(corner) % 2 == 0 ? delta : -delta;
+            for (size_t subset = 0; subset < trees_.size(); ++subset) {
+                Element value = signed_delta;
+                for (size_t dim = 0; dim < kDimensions; ++dim) {
+                    if (subset >> dim & 1) {
+                        value *= static_cast<Element>(point[dim]);
+                    }
+                }
+                trees_[subset].Update(point, value);
+            }
+        }
+    }
+
+    // Sum over the box low <= point <= high
+    Element Query(const Point& low, const Point& high) const {
+        Element result = Element();
+        for (size_t corner = 0; corner < (size_t(1) << kDimensions); ++corner) {
+            Point end;
+            bool empty = false;
+            for (size_t dim = 0; dim < kDimensions; ++dim) {
+                end[dim] = (corner >> dim & 1) ? low[dim] : high[dim] + 1;
+                empty |= end[dim] == 0;
+            }
+            if (empty) {
+                continue;
+            }
+            const Element prefix = PrefixQuery(end);
+            result = __builtin_popcountll(corner) % 2 == 0 ? result + prefix : result - prefix;
+        }
+        return result;
+    }
+
+private:
+    Point sizes_;
+    std::vector<Tree> trees_;
+
+    Element PrefixQuery(const Point& end) const {
+        Element result = Element();
+        for (size_t subset = 0; subset < trees_.size(); ++subset) {
+            Element value = trees_[subset].PrefixQuery(end);
+            for (size_t dim = 0; dim < kDimensions; ++dim) {
+                if (!(subset >> dim & 1)) {
+                    value *= static_cast<Element>(end[dim]);
+                }
+            }
+            result = __builtin_popcountll(subset) % 2 == 0 ? result + value : result - value;
+        }
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "binary_indexed_tree.h"
+
+// Builds a size^3 tree from values with the linear bulk constructor and with one Update per cell,
+// then times random box queries
+int main() {
+    size_t size;
+    size_t num_queries;
+    std::cin >> size >> num_queries;
+
+    using Tree = BinaryIndexedTree3D<int64_t, std::plus<int64_t>, std::minus<int64_t>>;
+    const Tree::Point sizes = { size, size, size };
+    std::mt19937_64 generator;
+    std::vector<int64_t> values(size * size * size);
+    for (auto& value : values) {
+        value = static_cast<int64_t>(generator() % 1000);
+    }
+
+    int64_t checksum = 0;
+    double bulk_seconds = MeasureSeconds([&]() {
+        Tree tree(sizes, values, 0);
+        checksum += tree.PrefixQuery(sizes);
+    });
+    double update_seconds = MeasureSeconds([&]() {
+        Tree tree(sizes, 0);
+        size_t cell = 0;
+        for (size_t z = 0; z < size; ++z) {
+            for (size_t y = 0; y < size; ++y) {
+                for (size_t x = 0; x < size; ++x) {
+                    tree.Update({ x, y, z }, values[cell++]);
+                }
+            }
+        }
+        checksum -= tree.PrefixQuery(sizes);
+    });
+    std::cout << "build " << size << "^3: bulk " << bulk_seconds << " s, Update per cell " << update_seconds << " s\n";
+
+    Tree tree(sizes, values, 0);
+    std::vector<std::pair<Tree::Point, Tree::Point>> queries(num_queries);
+    for (auto& [low, high] : queries) {
+        for (size_t dim = 0; dim < 3; ++dim) {
+            low[dim] = generator() % size;
+            high[dim] = low[dim] + generator() % (size - low[dim]);
+        }
+    }
+    double query_seconds = MeasureSeconds([&]() {
+        for (const auto& [low, high] : queries) {
+            checksum += tree.Query(low, high);
+        }
+    });
+    std::cout << "queries: " << num_queries / query_seconds / 1e6 << " M queries/s\n";
+    DoNotOptimize(checksum);
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+#ifndef RMQ_RSQ_TREES_BLOCK_SPARSE_TABLE_H
+#define RMQ_RSQ_TREES_BLOCK_SPARSE_TABLE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Operations that always return one of their arguments (min, max) declare
+// static constexpr bool kSelectsArgument = true and get the bitmask in-block queries
+template <class Operation, class = void>
+struct SelectsArgument : std::false_type {
+};
+
+template <class Operation>
+struct SelectsArgument<Operation, std::void_t<decltype(Operation::kSelectsArgument)>>
+    : std::integral_constant<bool, Operation::kSelectsArgument> {
+};
+
+// Sparse table for idempotent operations in O(n) memory. The array is cut into blocks of kBlockSize,
+// the full O(m log m) sparse table is kept only over the m = n / kBlockSize block results.
+// A query covering several blocks takes a suffix of the first block, the sparse table answer for
+// the blocks in between and a prefix of the last block.
+// In-block parts depend on the operation:
+// - selecting operations keep for every position the 32-bit mask of the candidates stack of its block:
+//   the answer over [l, r] inside a block is the first candidate of mask[r] not before l, one ctz;
+// - other idempotent operations (gcd) keep in-block prefix and suffix results, and a query inside
+//   a single block combines at most kBlockSize elements.
+// Blocks and levels of the table are built on threads_number threads. The table keeps the values,
+// so callers that do not need them any more move them in instead of holding a second copy.
+template <class Element, class Operation>
+class BlockSparseTable {
+public:
+    static constexpr size_t kBlockSize = 32;
+    static constexpr bool kSelection = SelectsArgument<Operation>::value;
+
+    explicit BlockSparseTable(std::vector<Element> values, size_t threads_number = 1)
+        : values_(std::move(values)), threads_number_(std::max<size_t>(threads_number, 1)) {
+        const size_t blocks_number = (values_.size() + kBlockSize - 1) / kBlockSize;
+        table_.emplace_back(blocks_number);
+        if (kSelection) {
+            masks_.resize(values_.size());
+        } else {
+            prefixes_.resize(values_.size());
+            suffixes_.resize(values_.size());
+        }
+        ParallelFor(blocks_number, [&](size_t block) { BuildBlock(block); });
+
+        for (size_t layer_no = 1; TwoPower(layer_no) <= blocks_number; ++layer_no) {
+            const std::vector<Element>& prev_layer = table_[layer_no - 1];
+            const size_t offset = TwoPower(layer_no - 1);
+            std::vector<Element> layer(prev_layer.size() - offset);
+            ParallelFor(layer.size(), [&](size_t i) { layer[i] = op_(prev_layer[i], prev_layer[i + offset]); });
+            table_.push_back(std::move(layer));
+        }
+    }
+
+    // Result over [left, right), left < right: operations like min have no result over an empty range
+    Element Query(size_t left, size_t right) const {
+        assert(left < right && right <= values_.size());
+        --right;
+        const size_t left_block = left / kBlockSize;
+        const size_t right_block = right / kBlockSize;
+        if (left_block == right_block) {
+            return QueryInBlock(left, right);
+        }
+        Element result = op_(Suffix(left), Prefix(right));
+        if (left_block + 1 < right_block) {
+            result = op_(result, QueryBlocks(left_block + 1, right_block));
+        }
+        return result;
+    }
+
+    size_t MemoryBytes() const {
+        size_t bytes = (values_.capacity() + prefixes_.capacity() + suffixes_.capacity()) * sizeof(Element) +
+                       masks_.capacity() * sizeof(uint32_t);
+        for (const auto& layer : table_) {
+            bytes += layer.capacity() * sizeof(Element);
+        }
+        return bytes;
+    }
+
+private:
+    std::vector<Element> values_;
+    std::vector<uint32_t> masks_;
+    std::vector<Element> prefixes_;
+    std::vector<Element> suffixes_;
+    // Layer k holds the results over 2^k blocks starting at every block
+    std::vector<std::vector<Element>> table_;
+    size_t threads_number_;
+    Operation op_;
+
+    static size_t TwoPower(size_t power) {
+        return 1ULL << power;
+    }
+
+    static size_t Log(size_t value) {
+        return 63 - __builtin_clzll(value);
+    }
+
+    // Calls function(i) for every i in [0, count), split into threads_number_ contiguous chunks
+    template <class Function>
+    void ParallelFor(size_t count, Function function) const {
+        const size_t threads_number = std::min(threads_number_, std::max<size_t>(count / kMinItemsPerThread, 1));
+        auto run_chunk = [&](size_t chunk) {
+            for (size_t i = count * chunk / threads_number; i < count * (chunk + 1) / threads_number; ++i) {
+                function(i);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t chunk = 1; chunk < threads_number; ++chunk) {
+            workers.emplace_back(run_chunk, chunk);
+        }
+        run_chunk(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    static constexpr size_t kMinItemsPerThread = 1 << 14;
+
+    void BuildBlock(size_t block) {
+        const size_t begin = block * kBlockSize;
+        const size_t end = std::min(begin + kBlockSize, values_.size());
+        if constexpr (kSelection) {
+            // Bit i of the mask is set while element begin + i is the answer for some range ending here
+            uint32_t mask = 0;
+            for (size_t i = begin; i < end; ++i) {
+                while (mask != 0) {
+                    const size_t top = begin + Log(mask);
+                    if (!IsSelected(values_[i], values_[top])) {
+                        break;
+                    }
+                    mask ^= uint32_t(1) << (top - begin);
+                }
+                mask |= uint32_t(1) << (i - begin);
+                masks_[i] = mask;
+            }
+            table_[0][block] = QueryInBlock(begin, end - 1);
+        } else {
+            prefixes_[begin] = values_[begin];
+            for (size_t i = begin + 1; i < end; ++i) {
+                prefixes_[i] = op_(prefixes_[i - 1], values_[i]);
+            }
+            suffixes_[end - 1] = values_[end - 1];
+            for (size_t i = end - 1; i > begin; --i) {
+                suffixes_[i - 1] = op_(values_[i - 1], suffixes_[i]);
+            }
+            table_[0][block] = prefixes_[end - 1];
+        }
+    }
+
+    // Whether the newer element wins against the older one, so the older one leaves the candidates
+    bool IsSelected(const Element& newer, const Element& older) const {
+        return op_(older, newer) == newer;
+    }
+
+    // [left, right], both inside one block
+    Element QueryInBlock(size_t left, size_t right) const {
+        if constexpr (kSelection) {
+            const size_t begin = left / kBlockSize * kBlockSize;
+            const uint32_t candidates = masks_[right] & (~uint32_t(0) << (left - begin));
+            return values_[begin + __builtin_ctz(candidates)];
+        } else {
+            Element result = values_[left];
+            for (size_t i = left + 1; i <= right; ++i) {
+                result = op_(result, values_[i]);
+            }
+            return result;
+        }
+    }
+
+    // From left to the end of its block
+    Element Suffix(size_t left) const {
+        if constexpr (kSelection) {
+            return QueryInBlock(left, left / kBlockSize * kBlockSize + kBlockSize - 1);
+        } else {
+            return suffixes_[left];
+        }
+    }
+
+    // From the beginning of the block to right
+    Element Prefix(size_t right) const {
+        if constexpr (kSelection) {
+            return QueryInBlock(right / kBlockSize * kBlockSize, right);
+        } else {
+            return prefixes_[right];
+        }
+    }
+
+    // Blocks [left_block, right_block)
+    Element QueryBlocks(size_t left_block, size_t right_block) const {
+        const size_t layer_no = Log(right_block - left_block);
+        return op_(table_[layer_no][left_block], table_[layer_no][right_block - TwoPower(layer_no)]);
+    }
+};
+
+#endif
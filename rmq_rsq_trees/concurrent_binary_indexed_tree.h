@@ -0,0 +1,143 @@
+#ifndef RMQ_RSQ_TREES_CONCURRENT_BINARY_INDEXED_TREE_H
+#define RMQ_RSQ_TREES_CONCURRENT_BINARY_INDEXED_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Fenwick trees for counters updated from many threads and read now and then.
+// A query sees all updates finished before it started; an update running next to it
+// may be counted in some cells and not in others.
+
+// Every cell is an atomic, updates are relaxed fetch_add, so Element must be integral
+// (floating point atomics have no fetch_add before C++20) and Op is +.
+// Any number of threads may update and query at once, but all of them contend on the same cells,
+// the low-numbered ones most of all.
+template <class Element>
+class AtomicBinaryIndexedTree {
+public:
+    static_assert(std::is_integral<Element>::value, "fetch_add needs an integral Element");
+
+    explicit AtomicBinaryIndexedTree(size_t size) : size_(size), tree_(new std::atomic<Element>[size]) {
+        for (size_t i = 0; i < size_; ++i) {
+            tree_[i].store(Element(), std::memory_order_relaxed);
+        }
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    void Update(size_t idx, const Element& delta) {
+        for (; idx < size_; idx = NextIncrement(idx)) {
+            tree_[idx].fetch_add(delta, std::memory_order_relaxed);
+        }
+    }
+
+    // Sum over [left, right], both inclusive
+    Element Query(size_t left, size_t right) const {
+        return PrefixQuery(right + 1) - PrefixQuery(left);
+    }
+
+private:
+    size_t size_;
+    std::unique_ptr<std::atomic<Element>[]> tree_;
+
+    static size_t NextIncrement(size_t idx) {
+        return idx | (idx + 1);
+    }
+
+    // Sum over [0, end)
+    Element PrefixQuery(size_t end) const {
+        Element result = Element();
+        for (; end > 0; end &= end - 1) {
+            result += tree_[end - 1].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+};
+
+// One tree per writer thread, a query combines the results of all shards with Op and the
+// inclusion-exclusion with InverseOp as BinaryIndexedTree does. Update(shard, ...) may only be
+// called by one thread per shard at a time: the writer owns its cells, so it stores the new value
+// with a plain relaxed store instead of a locked read-modify-write. Every shard starts on its own
+// cache line and is padded to whole lines, so writers of different shards never share a line.
+// Any trivially copyable Element works, and any Op with an inverse.
+template <class Element, class Op = std::plus<Element>, class InverseOp = std::minus<Element>>
+class ShardedBinaryIndexedTree {
+public:
+    static_assert(std::is_trivially_copyable<Element>::value, "cells are std::atomic<Element>");
+
+    ShardedBinaryIndexedTree(size_t size, size_t shards_number, const Element& neutral_element = Element(),
+                             const Op& oper = Op(), const InverseOp& inverse_oper = InverseOp())
+        : size_(size), oper_(oper), inverse_oper_(inverse_oper), neutral_element_(neutral_element) {
+        const size_t lines = std::max<size_t>((size_ * sizeof(Cell) + kCacheLineSize - 1) / kCacheLineSize, 1);
+        for (size_t shard = 0; shard < shards_number; ++shard) {
+            Cell* cells = static_cast<Cell*>(::operator new(lines * kCacheLineSize, std::align_val_t(kCacheLineSize)));
+            for (size_t i = 0; i < size_; ++i) {
+                new (cells + i) Cell(neutral_element_);
+            }
+            shards_.emplace_back(cells);
+        }
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t ShardsNumber() const {
+        return shards_.size();
+    }
+
+    void Update(size_t shard, size_t idx, const Element& delta) {
+        Cell* tree = shards_[shard].get();
+        for (; idx < size_; idx = NextIncrement(idx)) {
+            tree[idx].store(oper_(tree[idx].load(std::memory_order_relaxed), delta), std::memory_order_relaxed);
+        }
+    }
+
+    // Result over [left, right], both inclusive
+    Element Query(size_t left, size_t right) const {
+        return inverse_oper_(PrefixQuery(right + 1), PrefixQuery(left));
+    }
+
+private:
+    using Cell = std::atomic<Element>;
+
+    static constexpr size_t kCacheLineSize = 64;
+
+    // Cells are trivially destructible, so only the aligned storage is released
+    struct CellsDeleter {
+        void operator()(Cell* cells) const {
+            ::operator delete(cells, std::align_val_t(kCacheLineSize));
+        }
+    };
+
+    size_t size_;
+    std::vector<std::unique_ptr<Cell[], CellsDeleter>> shards_;
+    const Op oper_;
+    const InverseOp inverse_oper_;
+    const Element neutral_element_;
+
+    static size_t NextIncrement(size_t idx) {
+        return idx | (idx + 1);
+    }
+
+    // Result over [0, end) of all shards
+    Element PrefixQuery(size_t end) const {
+        Element result = neutral_element_;
+        for (const auto& shard : shards_) {
+            for (size_t cur_end = end; cur_end > 0; cur_end &= cur_end - 1) {
+                result = oper_(result, shard[cur_end - 1].load(std::memory_order_relaxed));
+            }
+        }
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "binary_indexed_tree.h"
+#include "concurrent_binary_indexed_tree.h"
+
+// threads_number writers increment random counters, one reader keeps asking for random ranges
+// until they finish. update(thread, idx) and query(left, right) wrap the tree under test.
+template <class UpdateFunction, class QueryFunction>
+void Run(const char* name, size_t size, size_t updates_per_thread, size_t threads_number,
+         UpdateFunction update, QueryFunction query) {
+    std::atomic<bool> done(false);
+    size_t reads = 0;
+    int64_t checksum = 0;
+    double seconds = MeasureSeconds([&]() {
+        std::thread reader([&]() {
+            std::mt19937_64 generator(threads_number);
+            while (!done.load()) {
+                const size_t left = generator() % size;
+                checksum += query(left, left + generator() % (size - left));
+                ++reads;
+            }
+        });
+        std::vector<std::thread> writers;
+        for (size_t thread = 0; thread < threads_number; ++thread) {
+            writers.emplace_back([&, thread]() {
+                std::mt19937_64 generator(thread);
+                for (size_t i = 0; i < updates_per_thread; ++i) {
+                    update(thread, generator() % size);
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        done.store(true);
+        reader.join();
+    });
+    const int64_t total = query(0, size - 1);
+    std::cout << name << ": " << threads_number * updates_per_thread / seconds / 1e6 << " M updates/s, "
+              << reads << " reads, total " << total << "\n";
+    DoNotOptimize(checksum);
+}
+
+int main() {
+    size_t size;
+    size_t updates_per_thread;
+    size_t threads_number;
+    std::cin >> size >> updates_per_thread >> threads_number;
+
+    {
+        using Tree = BinaryIndexedTree<int64_t, std::plus<int64_t>, std::minus<int64_t>, 1>;
+        Tree tree({ size }, 0);
+        std::mutex mutex;
+        Run("BinaryIndexedTree under a mutex", size, updates_per_thread, threads_number,
+            [&](size_t, size_t idx) {
+                std::lock_guard<std::mutex> lock(mutex);
+                tree.Update({ idx }, 1);
+            },
+            [&](size_t left, size_t right) {
+                std::lock_guard<std::mutex> lock(mutex);
+                return tree.Query({ left }, { right });
+            });
+    }
+    {
+        AtomicBinaryIndexedTree<int64_t> tree(size);
+        Run("AtomicBinaryIndexedTree", size, updates_per_thread, threads_number,
+            [&](size_t, size_t idx) { tree.Update(idx, 1); },
+            [&](size_t left, size_t right) { return tree.Query(left, right); });
+    }
+    {
+        ShardedBinaryIndexedTree<int64_t> tree(size, threads_number);
+        Run("ShardedBinaryIndexedTree", size, updates_per_thread, threads_number,
+            [&](size_t thread, size_t idx) { tree.Update(thread, idx, 1); },
+            [&](size_t left, size_t right) { return tree.Query(left, right); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#ifndef RMQ_RSQ_TREES_DYNAMIC_SEGMENT_TREE_H
+#define RMQ_RSQ_TREES_DYNAMIC_SEGMENT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "segment_tree.h"
+
+// Segment tree over an arbitrary [lo, hi) range of 64-bit coordinates, such as timestamps or ids,
+// without coordinate compression. Children are created only when an update or Set goes below a node,
+// so a node without children covers equal elements: the initial value with the node's tag applied.
+// Queries never allocate. Nodes live in one pool, the two children of a node are allocated together
+// and found by one 32-bit index, memory is O(log(hi - lo)) nodes per update, not O(hi - lo).
+// Monoid and Action are the policies of SegmentTree. The initial value should be a real element
+// value when the action adds to it (0 for sums, not the Neutral() of min).
+template <class Element, class Monoid, class Action = NoAction>
+class DynamicSegmentTree {
+public:
+    using Tag = typename Action::Tag;
+
+    DynamicSegmentTree(int64_t lo, int64_t hi, const Element& initial = Monoid::Neutral())
+        : lo_(lo), hi_(hi), initial_(initial), nodes_(1) {
+        root_ = NewNode(Length(lo, hi));
+    }
+
+    void Reserve(size_t count) {
+        nodes_.reserve(count + 1);
+    }
+
+    size_t NodesCount() const {
+        return nodes_.size() - 1;
+    }
+
+    // Result over [left, right), lo <= left <= right <= hi
+    Element Query(int64_t left, int64_t right) {
+        if (left >= right) {
+            return Monoid::Neutral();
+        }
+        return Query(root_, lo_, hi_, left, right);
+    }
+
+    void Update(int64_t left, int64_t right, const Tag& tag) {
+        if (left >= right) {
+            return;
+        }
+        Update(root_, lo_, hi_, left, right, tag);
+    }
+
+    Element Get(int64_t index) {
+        return Query(index, index + 1);
+    }
+
+    void Set(int64_t index, const Element& value) {
+        Set(root_, lo_, hi_, index, value);
+    }
+
+private:
+    using Index = uint32_t;
+    static constexpr Index kNull = 0;
+
+    struct Node {
+        Element result;
+        Tag tag;
+        // Left child, the right one follows it
+        Index children;
+    };
+
+    int64_t lo_;
+    int64_t hi_;
+    Element initial_;
+    std::vector<Node> nodes_;
+    Index root_;
+
+    // hi - lo may not fit into int64_t
+    static uint64_t Length(int64_t lo, int64_t hi) {
+        return static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    }
+
+    static int64_t Middle(int64_t lo, int64_t hi) {
+        return static_cast<int64_t>(static_cast<uint64_t>(lo) + Length(lo, hi) / 2);
+    }
+
+    Index NewNode(uint64_t length) {
+        nodes_.push_back({ Monoid::Repeat(initial_, length), Action::Identity(), kNull });
+        return static_cast<Index>(nodes_.size() - 1);
+    }
+
+    void ApplyToNode(Index node, const Tag& tag, uint64_t length) {
+        nodes_[node].result = Action::template Apply<Monoid>(tag, nodes_[node].result, length);
+        nodes_[node].tag = Action::Compose(tag, nodes_[node].tag);
+    }
+
+    // Creates missing children, then hands them the pending tag
+    void Push(Index node, int64_t lo, int64_t hi) {
+        const int64_t mid = Middle(lo, hi);
+        if (nodes_[node].children == kNull) {
+            const Index children = NewNode(Length(lo, mid));
+            NewNode(Length(mid, hi));
+            nodes_[node].children = children;
+        }
+        if (Action::IsIdentity(nodes_[node].tag)) {
+            return;
+        }
+        const Tag tag = nodes_[node].tag;
+        ApplyToNode(nodes_[node].children, tag, Length(lo, mid));
+        ApplyToNode(nodes_[node].children + 1, tag, Length(mid, hi));
+        nodes_[node].tag = Action::Identity();
+    }
+
+    void Pull(Index node) {
+        const Index children = nodes_[node].children;
+        nodes_[node].result = Monoid::Combine(nodes_[children].result, nodes_[children + 1].result);
+    }
+
+    Element Query(Index node, int64_t lo, int64_t hi, int64_t left, int64_t right) {
+        if (left <= lo && hi <= right) {
+            return nodes_[node].result;
+        }
+        if (nodes_[node].children == kNull) {
+            const uint64_t length = Length(std::max(lo, left), std::min(hi, right));
+            return Action::template Apply<Monoid>(nodes_[node].tag, Monoid::Repeat(initial_, length), length);
+        }
+        Push(node, lo, hi);
+        const int64_t mid = Middle(lo, hi);
+        if (right <= mid) {
+            return Query(nodes_[node].children, lo, mid, left, right);
+        }
+        if (left >= mid) {
+            return Query(nodes_[node].children + 1, mid, hi, left, right);
+        }
+        return Monoid::Combine(Query(nodes_[node].children, lo, mid, left, right),
+                               Query(nodes_[node].children + 1, mid, hi, left, right));
+    }
+
+    void Update(Index node, int64_t lo, int64_t hi, int64_t left, int64_t right, const Tag& tag) {
+        if (left <= lo && hi <= right) {
+            ApplyToNode(node, tag, Length(lo, hi));
+            return;
+        }
+        Push(node, lo, hi);
+        const int64_t mid = Middle(lo, hi);
+        if (left < mid) {
+            Update(nodes_[node].children, lo, mid, left, right, tag);
+        }
+        if (right > mid) {
+            Update(nodes_[node].children + 1, mid, hi, left, right, tag);
+        }
+        Pull(node);
+    }
+
+    void Set(Index node, int64_t lo, int64_t hi, int64_t index, const Element& value) {
+        if (Length(lo, hi) == 1) {
+            nodes_[node].result = value;
+            return;
+        }
+        Push(node, lo, hi);
+        const int64_t mid = Middle(lo, hi);
+        if (index < mid) {
+            Set(nodes_[node].children, lo, mid, index, value);
+        } else {
+            Set(nodes_[node].children + 1, mid, hi, index, value);
+        }
+        Pull(node);
+    }
+};
+
+#endif
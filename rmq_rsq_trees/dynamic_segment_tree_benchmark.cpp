@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "dynamic_segment_tree.h"
+
+struct Operation {
+    int type;
+    int64_t left;
+    int64_t right;
+    int64_t value;
+};
+
+// Operations on [left, right) of 40-bit coordinates, so sums stay inside int64_t:
+// a third add, a third assign and a third query.
+// Reports the throughput and how many nodes the updates materialized.
+int main() {
+    size_t num_operations;
+    std::cin >> num_operations;
+
+    const int64_t kLo = -(int64_t(1) << 39);
+    const int64_t kHi = int64_t(1) << 39;
+    std::mt19937_64 generator;
+    std::vector<Operation> operations(num_operations);
+    for (auto& operation : operations) {
+        operation.type = static_cast<int>(generator() % 3);
+        int64_t first = kLo + static_cast<int64_t>(generator() % (uint64_t(1) << 40));
+        int64_t second = kLo + static_cast<int64_t>(generator() % (uint64_t(1) << 40));
+        operation.left = std::min(first, second);
+        operation.right = std::max(first, second) + 1;
+        operation.value = static_cast<int64_t>(generator() % 1000);
+    }
+
+    using Action = AssignAddAction<int64_t>;
+    int64_t checksum = 0;
+    size_t nodes_count = 0;
+    double seconds = MeasureSeconds([&]() {
+        DynamicSegmentTree<int64_t, SumMonoid<int64_t>, Action> tree(kLo, kHi, 0);
+        for (const auto& operation : operations) {
+            if (operation.type == 0) {
+                tree.Update(operation.left, operation.right, Action::Add(operation.value));
+            } else if (operation.type == 1) {
+                tree.Update(operation.left, operation.right, Action::Assign(operation.value));
+            } else {
+                checksum += tree.Query(operation.left, operation.right);
+            }
+        }
+        nodes_count = tree.NodesCount();
+    });
+    std::cout << "DynamicSegmentTree: " << num_operations / seconds / 1e6 << " M operations/s, "
+              << nodes_count << " nodes, " << double(nodes_count) / num_operations << " nodes per operation\n";
+    DoNotOptimize(checksum);
+
+    return 0;
+}
@@ -1,64 +1,13 @@
 #include <iostream>
+#include <utility>
 #include <vector>
-
-#include <cmath>
-
-template <class Element, class Operation>
-class SparseTable {
-public:
-    explicit SparseTable(const std::vector<Element>& values) : table_(1, values) {
-        for (size_t i = 1; TwoPower(i) <= values.size(); ++i) {
-            table_.push_back(BuildLayer(table_[i - 1], i, op_));
-        }
-
-        precomputed_logs_ = PrecomputeLogs(values.size());
-    }
-
-    Element Query(size_t left, size_t right) {
-        size_t layer_no = Log(right - left);
-        size_t offset = TwoPower(layer_no);
-        return op_(table_[layer_no][left], table_[layer_no][right - offset]);
-    }
-
-private:
-    static size_t TwoPower(size_t power) {
-        return 1ULL << power;
-    }
-
-    static std::vector<Element> BuildLayer(const std::vector<Element>& prev_layer, size_t layer_no, Operation op) {
-        const size_t offset = TwoPower(layer_no - 1);
-        const size_t layer_size = prev_layer.size() - offset;
-        std::vector<Element> layer(layer_size);
-
-        for (size_t i = 0; i < layer_size; ++i) {
-            layer[i] = op(prev_layer[i], prev_layer[i + offset]);
-        }
-        return layer;
-    }
-
-    static std::vector<size_t> PrecomputeLogs(size_t size) {
-        std::vector<size_t> logs(size + 1, 0);
-
-        for (size_t i = 1; i < size; ++i) {
-            logs[i] = log2(i);
-        }
-        return logs;
-    }
-
-    size_t Log(size_t value) {
-        return precomputed_logs_[value];
-    }
-
-private:
-    std::vector<std::vector<Element>> table_;
-    Operation op_;
-
-    std::vector<size_t> precomputed_logs_;
-};
+#include "block_sparse_table.h"
 
 template <class T>
 class MinCounter {
 public:
+    static constexpr bool kSelectsArgument = true;
+
     T operator()(const T& lhs, const T& rhs) const {
         return std::min(lhs, rhs);
     }
@@ -84,11 +33,10 @@ struct Segment {
     size_t min;
 };
 
-Segment WorkWithSparseTable(const std::vector<size_t>& values, size_t first_left, size_t first_right,
-                            size_t num_queries) {
+Segment WorkWithSparseTable(std::vector<size_t> values, size_t first_left, size_t first_right, size_t num_queries) {
     const size_t num_elements = values.size();
 
-    SparseTable<size_t, MinCounter<size_t>> table(values);
+    BlockSparseTable<size_t, MinCounter<size_t>> table(std::move(values));
     size_t cur_left = first_left;
     size_t cur_right = first_right;
     size_t cur_min = table.Query(cur_left - 1, cur_right);
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <vector>
+#include "persistent_segment_tree.h"
+
+// Commands, indices from 1, version 0 is the input array:
+// s v i x - version v with a[i] = x, prints the new version
+// a v i x - version v with a[i] += x, prints the new version
+// q v l r - sum over [l, r] in version v
+// k l r k - k-th smallest of the input array over [l, r]
+// m v     - nodes and bytes version v added
+int main() {
+    size_t num_elements;
+    std::cin >> num_elements;
+
+    std::vector<int64_t> values(num_elements);
+    for (size_t i = 0; i < num_elements; ++i) {
+        std::cin >> values[i];
+    }
+
+    PersistentSegmentTree<int64_t, SumMonoid<int64_t>> tree(values);
+    RangeKthStatistic<int64_t> statistic(values);
+    size_t num_queries;
+    std::cin >> num_queries;
+    for (size_t i = 0; i < num_queries; ++i) {
+        char cmd;
+        std::cin >> cmd;
+
+        if (cmd == 's' || cmd == 'a') {
+            size_t version;
+            size_t index;
+            int64_t value;
+            std::cin >> version >> index >> value;
+
+            if (cmd == 's') {
+                std::cout << tree.Set(version, index - 1, value) << "\n";
+            } else {
+                std::cout << tree.Add(version, index - 1, value) << "\n";
+            }
+        } else if (cmd == 'q') {
+            size_t version;
+            size_t left;
+            size_t right;
+            std::cin >> version >> left >> right;
+
+            std::cout << tree.Query(version, left - 1, right) << "\n";
+        } else if (cmd == 'k') {
+            size_t left;
+            size_t right;
+            size_t k;
+            std::cin >> left >> right >> k;
+
+            std::cout << statistic.KStatistic(left - 1, right, k) << "\n";
+        } else {
+            size_t version;
+            std::cin >> version;
+
+            std::cout << tree.VersionNodes(version) << " " << tree.VersionBytes(version) << "\n";
+        }
+    }
+}
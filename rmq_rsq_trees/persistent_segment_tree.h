@@ -0,0 +1,225 @@
+#ifndef RMQ_RSQ_TREES_PERSISTENT_SEGMENT_TREE_H
+#define RMQ_RSQ_TREES_PERSISTENT_SEGMENT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "segment_tree.h"
+
+// Segment tree where every point update keeps the old tree intact: the O(log n) nodes on the path
+// to the element are copied into the arena, the rest is shared, and the copy gets a new root.
+// Versions are numbered in creation order, version 0 is the tree built from the elements;
+// an update may start from any version, so versions form a tree, not a line.
+// Monoid is a policy of SegmentTree.
+template <class Element, class Monoid>
+class PersistentSegmentTree {
+public:
+    explicit PersistentSegmentTree(const std::vector<Element>& elems)
+        : size_(elems.size()), span_(std::max<size_t>(size_, 1)) {
+        nodes_.reserve(2 * span_);
+        roots_.push_back(Build(elems, 0, span_));
+        version_nodes_.push_back(nodes_.size());
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t VersionsCount() const {
+        return roots_.size();
+    }
+
+    // Result over [left, right) in the given version
+    Element Query(size_t version, size_t left, size_t right) const {
+        if (left >= right) {
+            return Monoid::Neutral();
+        }
+        return Query(roots_[version], 0, span_, left, right);
+    }
+
+    Element Get(size_t version, size_t index) const {
+        Index node = roots_[version];
+        size_t lo = 0;
+        size_t hi = span_;
+        while (hi - lo > 1) {
+            const size_t mid = (lo + hi) / 2;
+            if (index < mid) {
+                node = nodes_[node].left;
+                hi = mid;
+            } else {
+                node = nodes_[node].right;
+                lo = mid;
+            }
+        }
+        return nodes_[node].result;
+    }
+
+    // Both return the number of the new version
+    size_t Set(size_t version, size_t index, const Element& value) {
+        return Update(version, index, [&](const Element&) { return value; });
+    }
+
+    // Combines value into the element, += for SumMonoid
+    size_t Add(size_t version, size_t index, const Element& value) {
+        return Update(version, index, [&](const Element& old) { return Monoid::Combine(old, value); });
+    }
+
+    // For counting trees (SumMonoid over counts): the index of the k-th counted item, k from 1,
+    // in the difference of two versions, base_version being the older one.
+    // Both roots are walked down together, so the difference is never materialized.
+    size_t FindKth(size_t version, size_t base_version, Element k) const {
+        Index node = roots_[version];
+        Index base = roots_[base_version];
+        size_t lo = 0;
+        size_t hi = span_;
+        while (hi - lo > 1) {
+            const size_t mid = (lo + hi) / 2;
+            const Element left_count = nodes_[nodes_[node].left].result - nodes_[nodes_[base].left].result;
+            if (k <= left_count) {
+                node = nodes_[node].left;
+                base = nodes_[base].left;
+                hi = mid;
+            } else {
+                k -= left_count;
+                node = nodes_[node].right;
+                base = nodes_[base].right;
+                lo = mid;
+            }
+        }
+        return lo;
+    }
+
+    // Memory report: nodes and bytes a version added on top of the versions it shares nodes with
+    size_t VersionNodes(size_t version) const {
+        return version_nodes_[version];
+    }
+
+    size_t VersionBytes(size_t version) const {
+        return version_nodes_[version] * sizeof(Node);
+    }
+
+    size_t MemoryBytes() const {
+        return nodes_.capacity() * sizeof(Node) + roots_.capacity() * sizeof(Index) +
+               version_nodes_.capacity() * sizeof(size_t);
+    }
+
+private:
+    using Index = uint32_t;
+
+    struct Node {
+        Element result;
+        Index left;
+        Index right;
+    };
+
+    size_t size_;
+    // Leaves in the tree, an empty tree still has one
+    size_t span_;
+    std::vector<Node> nodes_;
+    std::vector<Index> roots_;
+    std::vector<size_t> version_nodes_;
+    std::vector<Index> path_;
+
+    Index NewNode(const Node& node) {
+        nodes_.push_back(node);
+        return static_cast<Index>(nodes_.size() - 1);
+    }
+
+    Index Build(const std::vector<Element>& elems, size_t lo, size_t hi) {
+        if (hi - lo == 1) {
+            return NewNode({ lo < elems.size() ? elems[lo] : Monoid::Neutral(), 0, 0 });
+        }
+        const size_t mid = (lo + hi) / 2;
+        const Index left = Build(elems, lo, mid);
+        const Index right = Build(elems, mid, hi);
+        return NewNode({ Monoid::Combine(nodes_[left].result, nodes_[right].result), left, right });
+    }
+
+    Element Query(Index node, size_t lo, size_t hi, size_t left, size_t right) const {
+        if (left <= lo && hi <= right) {
+            return nodes_[node].result;
+        }
+        const size_t mid = (lo + hi) / 2;
+        if (right <= mid) {
+            return Query(nodes_[node].left, lo, mid, left, right);
+        }
+        if (left >= mid) {
+            return Query(nodes_[node].right, mid, hi, left, right);
+        }
+        return Monoid::Combine(Query(nodes_[node].left, lo, mid, left, right),
+                               Query(nodes_[node].right, mid, hi, left, right));
+    }
+
+    // Copies the path from the root to the leaf top-down, then recomputes it bottom-up
+    template <class Function>
+    size_t Update(size_t version, size_t index, Function new_value) {
+        const size_t nodes_before = nodes_.size();
+        Index node = NewNode(nodes_[roots_[version]]);
+        roots_.push_back(node);
+        path_.clear();
+        size_t lo = 0;
+        size_t hi = span_;
+        while (hi - lo > 1) {
+            path_.push_back(node);
+            const size_t mid = (lo + hi) / 2;
+            Index child;
+            if (index < mid) {
+                child = NewNode(nodes_[nodes_[node].left]);
+                nodes_[node].left = child;
+                hi = mid;
+            } else {
+                child = NewNode(nodes_[nodes_[node].right]);
+                nodes_[node].right = child;
+                lo = mid;
+            }
+            node = child;
+        }
+        nodes_[node].result = new_value(nodes_[node].result);
+        for (auto it = path_.rbegin(); it != path_.rend(); ++it) {
+            nodes_[*it].result = Monoid::Combine(nodes_[nodes_[*it].left].result, nodes_[nodes_[*it].right].result);
+        }
+        version_nodes_.push_back(nodes_.size() - nodes_before);
+        return roots_.size() - 1;
+    }
+};
+
+// k-th smallest element of a static array on [left, right) in O(log n): version i of a persistent
+// counting tree over the sorted values counts the first i elements, so version right minus
+// version left counts exactly the elements of [left, right)
+template <class T>
+class RangeKthStatistic {
+public:
+    explicit RangeKthStatistic(const std::vector<T>& values)
+        : sorted_(values), counts_(std::vector<uint32_t>(values.size(), 0)) {
+        std::sort(sorted_.begin(), sorted_.end());
+        // Equal values get consecutive ranks in order of appearance, so every rank is counted once
+        std::vector<size_t> order(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return values[lhs] < values[rhs]; });
+        std::vector<size_t> rank(values.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            rank[order[i]] = i;
+        }
+        for (size_t i = 0; i < values.size(); ++i) {
+            counts_.Add(i, rank[i], 1);
+        }
+    }
+
+    // k from 1, 1 <= k <= right - left
+    T KStatistic(size_t left, size_t right, size_t k) const {
+        return sorted_[counts_.FindKth(right, left, static_cast<uint32_t>(k))];
+    }
+
+    size_t MemoryBytes() const {
+        return sorted_.capacity() * sizeof(T) + counts_.MemoryBytes();
+    }
+
+private:
+    std::vector<T> sorted_;
+    PersistentSegmentTree<uint32_t, SumMonoid<uint32_t>> counts_;
+};
+
+#endif
@@ -1,14 +1,13 @@
 #include <iostream>
+#include <utility>
 #include <vector>
+#include "scan.h"
 
 template <class T>
 class PrefixSum {
 public:
-	PrefixSum(std::vector<T> arr) : array_(arr), sums_(arr.size(), 0) {
-		sums_[0] = array_[0];
-		for (size_t i = 1; i < array_.size(); ++i) {
-			sums_[i] = sums_[i - 1] + array_[i];
-		}
+	PrefixSum(std::vector<T> arr) : sums_(std::move(arr)) {
+		InclusiveScan(sums_.data(), sums_.size(), sums_.data());
 	}
 
 	T GetSum(int64_t left, int64_t right) const {
@@ -17,7 +16,6 @@ public:
 
 
 private:
-	std::vector<T> array_;
 	std::vector<T> sums_;
 
 	T GetSum(int64_t idx) const {
@@ -1,5 +1,7 @@
 #include <iostream>
+#include <thread>
 #include <vector>
+#include "scan.h"
 
 class Generator {
 public:
@@ -21,7 +23,8 @@ template <class T>
 class PrefixSum {
 public:
 	
-	explicit PrefixSum(int64_t size) : array_(size, 0), sums_(size, 0) {
+	// One extra cell takes the closing -add of segments that end at the last element
+	explicit PrefixSum(int64_t size) : sums_(size + 1, 0) {
 	}
 
 	void FillArray(int64_t m, Generator& nextRand) {
@@ -33,18 +36,16 @@ public:
 			if (l > r) {
 				std::swap(l, r);
 			}
-			array_[l] += add;
-			array_[r + 1] -= add;
+			sums_[l] += add;
+			sums_[r + 1] -= add;
 		}
 	}
 
-	void FillPrefix() {
-		unsigned value = array_[0];
-		sums_[0] = value;
-		for (unsigned i = 1; i < array_.size(); i++) {
-			value += array_[i];
-			sums_[i] = sums_[i - 1] + value;
-		}
+	// The first scan turns the differences into values, the second one into prefix sums of values,
+	// both in place, so no separate array of values is kept
+	void FillPrefix(size_t threads_number) {
+		ParallelInclusiveScan(sums_.data(), sums_.size(), sums_.data(), threads_number);
+		ParallelInclusiveScan(sums_.data(), sums_.size(), sums_.data(), threads_number);
 	}
 
 	T GetSum(int64_t left, int64_t right) const {
@@ -53,7 +54,6 @@ public:
 
 
 private:
-	std::vector<T> array_;
 	std::vector<T> sums_;
 
 	T GetSum(int64_t idx) const {
@@ -71,7 +71,7 @@ int main() {
 
 	PrefixSum<unsigned> arr(num_soldiers);
 	arr.FillArray(num_stages, nextRand);
-	arr.FillPrefix();
+	arr.FillPrefix(std::thread::hardware_concurrency());
 
 	unsigned result = 0;
 	for (unsigned i = 0; i < num_requests; ++i) {
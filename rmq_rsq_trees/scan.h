@@ -0,0 +1,174 @@
+#ifndef RMQ_RSQ_TREES_SCAN_H
+#define RMQ_RSQ_TREES_SCAN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Prefix scans over contiguous arrays with any associative Op. init is combined in front of
+// everything, so it must be Op's neutral element unless an offset is wanted.
+// All scans work in place (out == in). Integer sums, inclusive and exclusive, run through an
+// in-register SSE2 scan: a vector of 4 (or 2) elements is scanned with two (or one) shift-and-add
+// steps and the carry from the previous vector is broadcast and added.
+
+namespace scan_details {
+
+template <class T, class Op>
+constexpr bool kSimdSum = std::is_same<Op, std::plus<T>>::value && std::is_integral<T>::value &&
+                          (sizeof(T) == 4 || sizeof(T) == 8);
+
+#ifdef __SSE2__
+// Scans whole vectors from the start and returns how many elements it did; carry is updated.
+// The exclusive scan of a vector is the inclusive scan of the vector shifted up by one lane,
+// and the next carry is then its last lane plus the last input element
+template <bool kExclusive, class T>
+size_t SimdSum(const T* in, size_t size, T* out, T& carry) {
+    if constexpr (sizeof(T) == 4) {
+        __m128i vector_carry = _mm_set1_epi32(static_cast<int32_t>(carry));
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            __m128i scan = kExclusive ? _mm_slli_si128(x, 4) : x;
+            scan = _mm_add_epi32(scan, _mm_slli_si128(scan, 4));
+            scan = _mm_add_epi32(scan, _mm_slli_si128(scan, 8));
+            scan = _mm_add_epi32(scan, vector_carry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), scan);
+            vector_carry = _mm_shuffle_epi32(kExclusive ? _mm_add_epi32(scan, x) : scan, 0xFF);
+        }
+        carry = static_cast<T>(_mm_cvtsi128_si32(vector_carry));
+        return i;
+    } else {
+        __m128i vector_carry = _mm_set1_epi64x(static_cast<int64_t>(carry));
+        size_t i = 0;
+        for (; i + 2 <= size; i += 2) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            __m128i scan = kExclusive ? _mm_slli_si128(x, 8) : _mm_add_epi64(x, _mm_slli_si128(x, 8));
+            scan = _mm_add_epi64(scan, vector_carry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), scan);
+            const __m128i last = kExclusive ? _mm_add_epi64(scan, x) : scan;
+            vector_carry = _mm_unpackhi_epi64(last, last);
+        }
+        carry = static_cast<T>(_mm_cvtsi128_si64(vector_carry));
+        return i;
+    }
+}
+#endif
+
+}  // namespace scan_details
+
+// out[i] = init op in[0] op ... op in[i]; returns the result over everything
+template <class T, class Op = std::plus<T>>
+T InclusiveScan(const T* in, size_t size, T* out, T init = T(), Op op = Op()) {
+    size_t i = 0;
+#ifdef __SSE2__
+    if constexpr (scan_details::kSimdSum<T, Op>) {
+        i = scan_details::SimdSum<false>(in, size, out, init);
+    }
+#endif
+    for (; i < size; ++i) {
+        init = op(init, in[i]);
+        out[i] = init;
+    }
+    return init;
+}
+
+// out[i] = init op in[0] op ... op in[i - 1]; returns the result over everything
+template <class T, class Op = std::plus<T>>
+T ExclusiveScan(const T* in, size_t size, T* out, T init = T(), Op op = Op()) {
+    size_t i = 0;
+#ifdef __SSE2__
+    if constexpr (scan_details::kSimdSum<T, Op>) {
+        i = scan_details::SimdSum<true>(in, size, out, init);
+    }
+#endif
+    for (; i < size; ++i) {
+        const T value = in[i];
+        out[i] = init;
+        init = op(init, value);
+    }
+    return init;
+}
+
+template <class T, class Op = std::plus<T>>
+T Reduce(const T* in, size_t size, T init = T(), Op op = Op()) {
+    for (size_t i = 0; i < size; ++i) {
+        init = op(init, in[i]);
+    }
+    return init;
+}
+
+namespace scan_details {
+
+constexpr size_t kMinElementsPerThread = 1 << 16;
+
+// Two passes over threads_number contiguous chunks: every chunk is reduced on its own thread,
+// the chunk results are scanned serially into per-chunk offsets, then every chunk is scanned
+// from its offset. ScanChunk(in, size, out, offset) does the second pass of one chunk.
+template <class T, class Op, class ScanChunk>
+T ParallelScan(const T* in, size_t size, T* out, size_t threads_number, T init, Op op, ScanChunk scan_chunk) {
+    threads_number = std::max<size_t>(1, std::min(threads_number, size / kMinElementsPerThread));
+    if (threads_number == 1) {
+        return scan_chunk(in, size, out, init);
+    }
+    auto chunk_begin = [&](size_t chunk) { return size * chunk / threads_number; };
+    auto run_chunks = [&](auto function) {
+        std::vector<std::thread> workers;
+        for (size_t chunk = 1; chunk < threads_number; ++chunk) {
+            workers.emplace_back(function, chunk);
+        }
+        function(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    // Chunks are not empty, so each one is reduced from its first element and needs no neutral
+    std::vector<T> partials(threads_number, init);
+    run_chunks([&](size_t chunk) {
+        const T* chunk_in = in + chunk_begin(chunk);
+        partials[chunk] = Reduce(chunk_in + 1, chunk_begin(chunk + 1) - chunk_begin(chunk) - 1, chunk_in[0], op);
+    });
+    std::vector<T> offsets(threads_number, init);
+    for (size_t chunk = 1; chunk < threads_number; ++chunk) {
+        offsets[chunk] = op(offsets[chunk - 1], partials[chunk - 1]);
+    }
+    T total = init;
+    run_chunks([&](size_t chunk) {
+        const T result = scan_chunk(in + chunk_begin(chunk), chunk_begin(chunk + 1) - chunk_begin(chunk),
+                                    out + chunk_begin(chunk), offsets[chunk]);
+        if (chunk + 1 == threads_number) {
+            total = result;
+        }
+    });
+    return total;
+}
+
+}  // namespace scan_details
+
+// InclusiveScan split over threads_number threads. It reads the input twice, so it pays off
+// while the serial scan is bound by one core rather than by memory bandwidth.
+template <class T, class Op = std::plus<T>>
+T ParallelInclusiveScan(const T* in, size_t size, T* out, size_t threads_number, T init = T(), Op op = Op()) {
+    return scan_details::ParallelScan(in, size, out, threads_number, init, op,
+                                      [&](const T* chunk_in, size_t chunk_size, T* chunk_out, const T& offset) {
+                                          return InclusiveScan(chunk_in, chunk_size, chunk_out, offset, op);
+                                      });
+}
+
+template <class T, class Op = std::plus<T>>
+T ParallelExclusiveScan(const T* in, size_t size, T* out, size_t threads_number, T init = T(), Op op = Op()) {
+    return scan_details::ParallelScan(in, size, out, threads_number, init, op,
+                                      [&](const T* chunk_in, size_t chunk_size, T* chunk_out, const T& offset) {
+                                          return ExclusiveScan(chunk_in, chunk_size, chunk_out, offset, op);
+                                      });
+}
+
+#endif
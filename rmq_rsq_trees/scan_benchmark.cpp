@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "scan.h"
+
+// Same as std::plus, but a different type, so InclusiveScan takes the scalar loop
+template <class T>
+struct ScalarPlus {
+    T operator()(const T& lhs, const T& rhs) const {
+        return lhs + rhs;
+    }
+};
+
+template <class T>
+void Run(const char* name, size_t size) {
+    std::mt19937_64 generator;
+    std::vector<T> values(size);
+    for (auto& value : values) {
+        value = static_cast<T>(generator() % 1000);
+    }
+    std::vector<T> out(size);
+    const size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    T checksum = 0;
+
+    double partial_sum = MeasureSeconds([&]() { std::partial_sum(values.begin(), values.end(), out.begin()); });
+    checksum += out.back();
+    double scalar = MeasureSeconds([&]() {
+        checksum += InclusiveScan(values.data(), size, out.data(), T(), ScalarPlus<T>());
+    });
+    double simd = MeasureSeconds([&]() { checksum += InclusiveScan(values.data(), size, out.data()); });
+    double parallel = MeasureSeconds([&]() {
+        checksum += ParallelInclusiveScan(values.data(), size, out.data(), hardware_threads);
+    });
+    std::cout << name << ": std::partial_sum " << partial_sum << " s, scalar " << scalar << " s, SIMD " << simd
+              << " s, SIMD on " << hardware_threads << " threads " << parallel << " s\n";
+    DoNotOptimize(checksum);
+}
+
+int main() {
+    size_t size;
+    std::cin >> size;
+
+    Run<uint32_t>("uint32_t", size);
+    Run<int64_t>("int64_t", size);
+
+    return 0;
+}
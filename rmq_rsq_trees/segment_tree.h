@@ -0,0 +1,365 @@
+#ifndef RMQ_RSQ_TREES_SEGMENT_TREE_H
+#define RMQ_RSQ_TREES_SEGMENT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Monoids are stateless: Neutral() and Combine() as in the Op classes of the other trees,
+// Repeat(x, length) combines length copies of x, which is what GroupOp computed for sums
+template <class T>
+struct SumMonoid {
+    static T Neutral() {
+        return T();
+    }
+
+    static T Combine(const T& lhs, const T& rhs) {
+        return lhs + rhs;
+    }
+
+    static T Repeat(const T& value, size_t length) {
+        return value * static_cast<T>(length);
+    }
+};
+
+template <class T>
+struct MinMonoid {
+    static T Neutral() {
+        return std::numeric_limits<T>::max();
+    }
+
+    static T Combine(const T& lhs, const T& rhs) {
+        return std::min(lhs, rhs);
+    }
+
+    static T Repeat(const T& value, size_t) {
+        return value;
+    }
+};
+
+template <class T>
+struct MaxMonoid {
+    static T Neutral() {
+        return std::numeric_limits<T>::lowest();
+    }
+
+    static T Combine(const T& lhs, const T& rhs) {
+        return std::max(lhs, rhs);
+    }
+
+    static T Repeat(const T& value, size_t) {
+        return value;
+    }
+};
+
+// Actions: Apply(tag, result, length) updates the result of a segment of length elements,
+// Compose(newer, older) is the tag that does older first and newer second,
+// IsIdentity(tag) lets pushes skip nodes without pending updates
+struct NoAction {
+    struct Tag {
+    };
+
+    static Tag Identity() {
+        return {};
+    }
+
+    static bool IsIdentity(const Tag&) {
+        return true;
+    }
+
+    static Tag Compose(const Tag&, const Tag&) {
+        return {};
+    }
+
+    template <class Monoid, class Element>
+    static Element Apply(const Tag&, const Element& result, size_t) {
+        return result;
+    }
+};
+
+// x -> (assign ? value : x) + add, covers range-assign, range-add and their mixes
+template <class Element>
+struct AssignAddAction {
+    struct Tag {
+        bool assign;
+        Element value;
+        Element add;
+    };
+
+    static Tag Identity() {
+        return { false, Element(), Element() };
+    }
+
+    static Tag Assign(const Element& value) {
+        return { true, value, Element() };
+    }
+
+    static Tag Add(const Element& add) {
+        return { false, Element(), add };
+    }
+
+    static bool IsIdentity(const Tag& tag) {
+        return !tag.assign && tag.add == Element();
+    }
+
+    static Tag Compose(const Tag& newer, const Tag& older) {
+        if (newer.assign) {
+            return newer;
+        }
+        return { older.assign, older.value, older.add + newer.add };
+    }
+
+    template <class Monoid>
+    static Element Apply(const Tag& tag, const Element& result, size_t length) {
+        const Element base = tag.assign ? Monoid::Repeat(tag.value, length) : result;
+        return base + Monoid::Repeat(tag.add, length);
+    }
+};
+
+// Bottom-up segment tree over [leaves_, 2 * leaves_): queries and updates on [left, right) start at
+// left + leaves_ and right + leaves_ and climb, so nothing recurses. Only the tags above the two
+// borders are pushed before and results on the borders are recomputed after an update.
+// leaves_ is the smallest power of two not less than the size, tags are kept for inner nodes only.
+template <class Element, class Monoid, class Action = NoAction>
+class SegmentTree {
+public:
+    using Tag = typename Action::Tag;
+    static constexpr bool kHasAction = !std::is_same<Action, NoAction>::value;
+
+    explicit SegmentTree(const std::vector<Element>& elems) : size_(elems.size()) {
+        while ((size_t(1) << height_) < size_) {
+            ++height_;
+        }
+        leaves_ = size_t(1) << height_;
+        tree_.assign(2 * leaves_, Monoid::Neutral());
+        tags_.assign(kHasAction ? leaves_ : 0, Action::Identity());
+
+        std::copy(elems.begin(), elems.end(), tree_.begin() + leaves_);
+        for (size_t i = leaves_ - 1; i > 0; --i) {
+            Pull(i);
+        }
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    Element Query(size_t left, size_t right) {
+        if (left >= right) {
+            return Monoid::Neutral();
+        }
+        PushBorders(left + leaves_, right + leaves_);
+        return Climb(left, right);
+    }
+
+    // Answers a batch of [left, right) queries offline. Pending tags are pushed to the leaves once,
+    // after that the tree is only read, so the batch is cut into chunks answered on threads_number threads.
+    // A chunk with many queries is sorted into a divide and conquer sweep over the leaves: queries
+    // crossing the middle of a segment combine a suffix and a prefix computed from the middle,
+    // the rest go down to the halves. Small chunks climb the tree query by query.
+    std::vector<Element> QueryBatch(const std::vector<std::pair<size_t, size_t>>& queries, size_t threads_number = 1) {
+        PushAll();
+        std::vector<Element> answers(queries.size(), Monoid::Neutral());
+        threads_number = std::max<size_t>(1, std::min(threads_number, queries.size() / kMinQueriesPerThread));
+        if (threads_number == 1) {
+            AnswerChunk(queries, 0, queries.size(), answers);
+            return answers;
+        }
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < threads_number; ++i) {
+            workers.emplace_back([&, i]() {
+                AnswerChunk(queries, queries.size() * i / threads_number, queries.size() * (i + 1) / threads_number,
+                            answers);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return answers;
+    }
+
+    void Update(size_t left, size_t right, const Tag& tag) {
+        if (left >= right) {
+            return;
+        }
+        left += leaves_;
+        right += leaves_;
+        PushBorders(left, right);
+
+        size_t length = 1;
+        for (size_t cur_left = left, cur_right = right; cur_left < cur_right;
+             cur_left >>= 1, cur_right >>= 1, length <<= 1) {
+            if (cur_left & 1) {
+                ApplyToNode(cur_left++, tag, length);
+            }
+            if (cur_right & 1) {
+                ApplyToNode(--cur_right, tag, length);
+            }
+        }
+
+        for (size_t level = 1; level <= height_; ++level) {
+            if (((left >> level) << level) != left) {
+                Pull(left >> level);
+            }
+            if (((right >> level) << level) != right) {
+                Pull((right - 1) >> level);
+            }
+        }
+    }
+
+    Element Get(size_t index) {
+        index += leaves_;
+        PushBorders(index, index + 1);
+        return tree_[index];
+    }
+
+    void Set(size_t index, const Element& value) {
+        index += leaves_;
+        PushBorders(index, index + 1);
+        tree_[index] = value;
+        for (index >>= 1; index > 0; index >>= 1) {
+            Pull(index);
+        }
+    }
+
+private:
+    size_t size_;
+    size_t height_ = 0;
+    size_t leaves_;
+    std::vector<Element> tree_;
+    std::vector<Tag> tags_;
+
+    static constexpr size_t kMinQueriesPerThread = 1 << 12;
+
+    // Bottom-up query for trees without pending tags on the borders
+    Element Climb(size_t left, size_t right) const {
+        Element left_res = Monoid::Neutral();
+        Element right_res = Monoid::Neutral();
+        for (left += leaves_, right += leaves_; left < right; left >>= 1, right >>= 1) {
+            if (left & 1) {
+                left_res = Monoid::Combine(left_res, tree_[left++]);
+            }
+            if (right & 1) {
+                right_res = Monoid::Combine(tree_[--right], right_res);
+            }
+        }
+        return Monoid::Combine(left_res, right_res);
+    }
+
+    void PushAll() {
+        if (!kHasAction) {
+            return;
+        }
+        for (size_t node = 1; node < leaves_; ++node) {
+            Push(node);
+        }
+    }
+
+    void AnswerChunk(const std::vector<std::pair<size_t, size_t>>& queries, size_t begin, size_t end,
+                     std::vector<Element>& answers) const {
+        // The sweep touches every leaf up to log(size) times, climbing costs log(size) per query
+        if ((end - begin) * (height_ + 1) < size_) {
+            for (size_t i = begin; i < end; ++i) {
+                answers[i] = Climb(queries[i].first, queries[i].second);
+            }
+            return;
+        }
+        std::vector<size_t> order;
+        for (size_t i = begin; i < end; ++i) {
+            if (queries[i].first < queries[i].second) {
+                order.push_back(i);
+            }
+        }
+        std::vector<Element> scratch(size_);
+        Sweep(0, size_, order.begin(), order.end(), queries, answers, scratch);
+    }
+
+    void Sweep(size_t segment_left, size_t segment_right, std::vector<size_t>::iterator first,
+               std::vector<size_t>::iterator last, const std::vector<std::pair<size_t, size_t>>& queries,
+               std::vector<Element>& answers, std::vector<Element>& scratch) const {
+        if (first == last) {
+            return;
+        }
+        const Element* leaves = tree_.data() + leaves_;
+        if (segment_right - segment_left == 1) {
+            for (auto it = first; it != last; ++it) {
+                answers[*it] = leaves[segment_left];
+            }
+            return;
+        }
+        const size_t mid = (segment_left + segment_right) / 2;
+        auto left_end = std::partition(first, last, [&](size_t query) { return queries[query].second <= mid; });
+        auto crossing_begin = std::partition(left_end, last, [&](size_t query) { return queries[query].first >= mid; });
+
+        if (crossing_begin != last) {
+            size_t min_left = mid;
+            size_t max_right = mid;
+            for (auto it = crossing_begin; it != last; ++it) {
+                min_left = std::min(min_left, queries[*it].first);
+                max_right = std::max(max_right, queries[*it].second);
+            }
+            scratch[mid - 1] = leaves[mid - 1];
+            for (size_t i = mid - 1; i > min_left; --i) {
+                scratch[i - 1] = Monoid::Combine(leaves[i - 1], scratch[i]);
+            }
+            scratch[mid] = leaves[mid];
+            for (size_t i = mid + 1; i < max_right; ++i) {
+                scratch[i] = Monoid::Combine(scratch[i - 1], leaves[i]);
+            }
+            for (auto it = crossing_begin; it != last; ++it) {
+                answers[*it] = Monoid::Combine(scratch[queries[*it].first], scratch[queries[*it].second - 1]);
+            }
+        }
+
+        Sweep(segment_left, mid, first, left_end, queries, answers, scratch);
+        Sweep(mid, segment_right, left_end, crossing_begin, queries, answers, scratch);
+    }
+
+    // Node 1 covers all leaves_ elements, every level below halves the length
+    size_t Length(size_t node) const {
+        return leaves_ >> (63 - __builtin_clzll(node));
+    }
+
+    void Pull(size_t node) {
+        tree_[node] = Monoid::Combine(tree_[2 * node], tree_[2 * node + 1]);
+    }
+
+    void ApplyToNode(size_t node, const Tag& tag, size_t length) {
+        tree_[node] = Action::template Apply<Monoid>(tag, tree_[node], length);
+        if (node < leaves_) {
+            tags_[node] = Action::Compose(tag, tags_[node]);
+        }
+    }
+
+    void Push(size_t node) {
+        if (Action::IsIdentity(tags_[node])) {
+            return;
+        }
+        const size_t child_length = Length(node) / 2;
+        ApplyToNode(2 * node, tags_[node], child_length);
+        ApplyToNode(2 * node + 1, tags_[node], child_length);
+        tags_[node] = Action::Identity();
+    }
+
+    // Pushes tags on the paths to the nodes that contain a border of [left, right) strictly inside
+    void PushBorders(size_t left, size_t right) {
+        if (!kHasAction) {
+            return;
+        }
+        for (size_t level = height_; level > 0; --level) {
+            if (((left >> level) << level) != left) {
+                Push(left >> level);
+            }
+            if (((right >> level) << level) != right) {
+                Push((right - 1) >> level);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "segment_tree_2d.h"
+
+struct Rectangle {
+    size_t left;
+    size_t top;
+    size_t right;
+    size_t bottom;
+};
+
+class MinCounter {
+public:
+    int32_t operator()(int32_t lhs, int32_t rhs) const {
+        return std::min(lhs, rhs);
+    }
+};
+
+template <class Structure>
+void Run(const char* name, const Structure& structure, const std::vector<Rectangle>& queries) {
+    int64_t checksum = 0;
+    double seconds = MeasureSeconds([&]() {
+        for (const auto& query : queries) {
+            checksum += structure.Query(query.left, query.top, query.right, query.bottom);
+        }
+    });
+    std::cout << name << ": " << queries.size() / seconds / 1e6 << " M queries/s\n";
+    DoNotOptimize(checksum);
+}
+
+int main() {
+    size_t height;
+    size_t width;
+    size_t num_queries;
+    std::cin >> height >> width >> num_queries;
+
+    std::mt19937_64 generator;
+    std::vector<std::vector<int32_t>> values(height, std::vector<int32_t>(width));
+    for (auto& row : values) {
+        for (auto& value : row) {
+            value = static_cast<int32_t>(generator() % 1000000);
+        }
+    }
+    std::vector<Rectangle> queries(num_queries);
+    for (auto& query : queries) {
+        std::tie(query.top, query.bottom) = std::minmax(generator() % height, generator() % height);
+        std::tie(query.left, query.right) = std::minmax(generator() % width, generator() % width);
+        ++query.bottom;
+        ++query.right;
+    }
+
+    double tree_build = 0;
+    double table_build = 0;
+    size_t tree_bytes = 0;
+    size_t table_bytes = 0;
+    {
+        std::unique_ptr<SegmentTree2D<int32_t, MinCounter>> tree;
+        tree_build = MeasureSeconds([&]() {
+            tree = std::make_unique<SegmentTree2D<int32_t, MinCounter>>(values, std::numeric_limits<int32_t>::max());
+        });
+        Run("SegmentTree2D", *tree, queries);
+        tree_bytes = tree->MemoryBytes();
+    }
+    {
+        std::unique_ptr<SparseTable2D<int32_t, MinCounter>> table;
+        table_build = MeasureSeconds([&]() {
+            table = std::make_unique<SparseTable2D<int32_t, MinCounter>>(values);
+        });
+        Run("SparseTable2D", *table, queries);
+        table_bytes = table->MemoryBytes();
+    }
+    std::cout << "build: SegmentTree2D " << tree_build << " s, SparseTable2D " << table_build << " s\n";
+    std::cout << "memory: SegmentTree2D " << (tree_bytes >> 20) << " MB, SparseTable2D " << (table_bytes >> 20) << " MB\n";
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "segment_tree.h"
+
+struct Operation {
+    int type;
+    size_t left;
+    size_t right;
+    int64_t value;
+};
+
+// A third of the operations add to a range, a third assign it and a third query it
+template <class Monoid>
+void Run(const char* name, const std::vector<int64_t>& values, const std::vector<Operation>& operations) {
+    using Action = AssignAddAction<int64_t>;
+    SegmentTree<int64_t, Monoid, Action> tree(values);
+    int64_t checksum = 0;
+    double seconds = MeasureSeconds([&]() {
+        for (const auto& operation : operations) {
+            if (operation.type == 0) {
+                tree.Update(operation.left, operation.right, Action::Add(operation.value));
+            } else if (operation.type == 1) {
+                tree.Update(operation.left, operation.right, Action::Assign(operation.value));
+            } else {
+                checksum += tree.Query(operation.left, operation.right);
+            }
+        }
+    });
+    std::cout << name << ": " << operations.size() << " operations " << seconds << " s, "
+              << operations.size() / seconds / 1e6 << " M operations/s\n";
+    DoNotOptimize(checksum);
+}
+
+// The same read batch answered query by query, by one sweep, and by sweeps on all cores
+template <class Monoid>
+void RunBatch(const char* name, const std::vector<int64_t>& values,
+              const std::vector<std::pair<size_t, size_t>>& queries) {
+    SegmentTree<int64_t, Monoid> tree(values);
+    const size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    int64_t checksum = 0;
+    double one_by_one = MeasureSeconds([&]() {
+        for (auto [left, right] : queries) {
+            checksum += tree.Query(left, right);
+        }
+    });
+    double batch = MeasureSeconds([&]() {
+        checksum += tree.QueryBatch(queries).back();
+    });
+    double parallel_batch = MeasureSeconds([&]() {
+        checksum += tree.QueryBatch(queries, hardware_threads).back();
+    });
+    std::cout << name << ": " << queries.size() << " queries one by one " << one_by_one << " s, QueryBatch "
+              << batch << " s, QueryBatch on " << hardware_threads << " threads " << parallel_batch << " s\n";
+    DoNotOptimize(checksum);
+}
+
+int main() {
+    size_t num_elements;
+    size_t num_operations;
+    std::cin >> num_elements >> num_operations;
+
+    std::mt19937_64 generator;
+    std::vector<int64_t> values(num_elements);
+    for (auto& value : values) {
+        value = static_cast<int64_t>(generator() % 1000);
+    }
+    std::vector<Operation> operations(num_operations);
+    for (auto& operation : operations) {
+        operation.type = static_cast<int>(generator() % 3);
+        operation.left = generator() % num_elements;
+        operation.right = operation.left + 1 + generator() % (num_elements - operation.left);
+        operation.value = static_cast<int64_t>(generator() % 1000);
+    }
+
+    Run<SumMonoid<int64_t>>("sum", values, operations);
+    Run<MinMonoid<int64_t>>("min", values, operations);
+
+    std::vector<std::pair<size_t, size_t>> queries;
+    for (const auto& operation : operations) {
+        queries.emplace_back(operation.left, operation.right);
+    }
+    RunBatch<SumMonoid<int64_t>>("sum batch", values, queries);
+    RunBatch<MinMonoid<int64_t>>("min batch", values, queries);
+
+    return 0;
+}
@@ -0,0 +1,600 @@
+#ifndef RMQ_RSQ_TREES_WIDE_SEGMENT_TREE_H
+#define RMQ_RSQ_TREES_WIDE_SEGMENT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <sys/mman.h>
+#include "segment_tree.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
+// GCC and Clang on x86-64 compile AVX2 and AVX-512 query paths next to the default one and pick one at runtime
+#if defined(__SSE2__) && defined(__x86_64__) && defined(__GNUC__)
+#define WIDE_SEGMENT_TREE_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace wide_segment_tree_details {
+
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kHugePageSize = 2 << 20;
+
+// Nodes are read whole, so every level starts on a cache line boundary. A query touches a few random
+// nodes far apart, so at large sizes translation misses cost as much as cache misses: buffers of at
+// least a huge page are aligned to it and asked to be backed by huge pages
+template <class T>
+struct CacheLineAllocator {
+    using value_type = T;
+
+    CacheLineAllocator() = default;
+
+    template <class U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {
+    }
+
+    T* allocate(size_t count) {
+        const size_t bytes = count * sizeof(T);
+        void* data = ::operator new(bytes, Alignment(bytes));
+#ifdef MADV_HUGEPAGE
+        if (bytes >= kHugePageSize) {
+            madvise(data, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<T*>(data);
+    }
+
+    void deallocate(T* data, size_t count) {
+        ::operator delete(data, Alignment(count * sizeof(T)));
+    }
+
+    static std::align_val_t Alignment(size_t bytes) {
+        return std::align_val_t(bytes >= kHugePageSize ? kHugePageSize : kCacheLineSize);
+    }
+
+    template <class U>
+    bool operator==(const CacheLineAllocator<U>&) const {
+        return true;
+    }
+
+    template <class U>
+    bool operator!=(const CacheLineAllocator<U>&) const {
+        return false;
+    }
+};
+
+// Lanes accumulate the nodes of one query: Accumulate(node, from, to) takes lanes [from, to) of a node,
+// AccumulateSuffix and AccumulatePrefix the lanes from from on and before to, and Result() is the result
+// over everything taken so far.
+// Any Monoid: lanes are combined one by one into a single accumulator
+template <class Element, class Monoid, size_t kBranching>
+class ScalarLanes {
+public:
+    void Accumulate(const Element* node, size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            accumulator_ = Monoid::Combine(accumulator_, node[i]);
+        }
+    }
+
+    void AccumulateSuffix(const Element* node, size_t from) {
+        Accumulate(node, from, kBranching);
+    }
+
+    void AccumulatePrefix(const Element* node, size_t to) {
+        Accumulate(node, 0, to);
+    }
+
+    Element Result() const {
+        return accumulator_;
+    }
+
+private:
+    Element accumulator_ = Monoid::Neutral();
+};
+
+// kBranching zeros, kBranching ones and kBranching zeros: the window of a node at kBranching - from
+// has ones from lane from on, the window at 2 * kBranching - to has ones up to lane to
+template <size_t kBranching>
+struct LaneMasks {
+    alignas(kCacheLineSize) int32_t values[3 * kBranching] = {};
+
+    constexpr LaneMasks() {
+        for (size_t i = kBranching; i < 2 * kBranching; ++i) {
+            values[i] = -1;
+        }
+    }
+
+    static const LaneMasks kTable;
+};
+
+template <size_t kBranching>
+const LaneMasks<kBranching> LaneMasks<kBranching>::kTable{};
+
+// Lane-wise Combine on four 32-bit integers for the monoids that have one, and Select that keeps
+// the lanes set in mask and puts Neutral() into the others
+template <class Element, class Monoid>
+struct SimdCombine {
+    static constexpr bool kSupported = false;
+};
+
+#ifdef __SSE2__
+template <>
+struct SimdCombine<int32_t, SumMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    static __m128i Combine(__m128i lhs, __m128i rhs) {
+        return _mm_add_epi32(lhs, rhs);
+    }
+
+    static __m128i Select(__m128i mask, __m128i value) {
+        return _mm_and_si128(mask, value);
+    }
+};
+
+template <>
+struct SimdCombine<int32_t, MinMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    static __m128i Combine(__m128i lhs, __m128i rhs) {
+#ifdef __SSE4_1__
+        return _mm_min_epi32(lhs, rhs);
+#else
+        const __m128i less = _mm_cmplt_epi32(lhs, rhs);
+        return _mm_or_si128(_mm_and_si128(less, lhs), _mm_andnot_si128(less, rhs));
+#endif
+    }
+
+    static __m128i Select(__m128i mask, __m128i value) {
+        const __m128i neutral = _mm_set1_epi32(MinMonoid<int32_t>::Neutral());
+#ifdef __SSE4_1__
+        return _mm_blendv_epi8(neutral, value, mask);
+#else
+        return _mm_or_si128(_mm_and_si128(mask, value), _mm_andnot_si128(mask, neutral));
+#endif
+    }
+};
+
+template <>
+struct SimdCombine<int32_t, MaxMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    static __m128i Combine(__m128i lhs, __m128i rhs) {
+#ifdef __SSE4_1__
+        return _mm_max_epi32(lhs, rhs);
+#else
+        const __m128i greater = _mm_cmpgt_epi32(lhs, rhs);
+        return _mm_or_si128(_mm_and_si128(greater, lhs), _mm_andnot_si128(greater, rhs));
+#endif
+    }
+
+    static __m128i Select(__m128i mask, __m128i value) {
+        const __m128i neutral = _mm_set1_epi32(MaxMonoid<int32_t>::Neutral());
+#ifdef __SSE4_1__
+        return _mm_blendv_epi8(neutral, value, mask);
+#else
+        return _mm_or_si128(_mm_and_si128(mask, value), _mm_andnot_si128(mask, neutral));
+#endif
+    }
+};
+
+// Four lanes accumulate all the nodes of a query and are reduced once at the end.
+// Lane i of a node takes part when from <= i < to: the mask is a LaneMasks window, or the AND of two
+// when the node is cut from both sides. No branches and few instructions per node, so the cache misses
+// of consecutive queries can overlap
+template <class Element, class Monoid, size_t kBranching>
+class SimdLanes {
+public:
+    SimdLanes() : accumulator_(_mm_set1_epi32(Monoid::Neutral())) {
+    }
+
+    void Accumulate(const Element* node, size_t from, size_t to) {
+        AccumulateMasked<true, true>(node, from, to);
+    }
+
+    void AccumulateSuffix(const Element* node, size_t from) {
+        AccumulateMasked<true, false>(node, from, kBranching);
+    }
+
+    void AccumulatePrefix(const Element* node, size_t to) {
+        AccumulateMasked<false, true>(node, 0, to);
+    }
+
+    Element Result() const {
+        __m128i result = Combiner::Combine(accumulator_, _mm_shuffle_epi32(accumulator_, 0x4E));
+        result = Combiner::Combine(result, _mm_shuffle_epi32(result, 0xB1));
+        return _mm_cvtsi128_si32(result);
+    }
+
+private:
+    using Combiner = SimdCombine<Element, Monoid>;
+
+    __m128i accumulator_;
+
+    // kFromMask and kToMask tell which sides of the node are cut
+    template <bool kFromMask, bool kToMask>
+    void AccumulateMasked(const Element* node, size_t from, size_t to) {
+        const int32_t* masks = LaneMasks<kBranching>::kTable.values;
+        accumulator_ = Combiner::Combine(accumulator_, CombineVectors<0, kBranching / 4, kFromMask, kToMask>(
+                                                           reinterpret_cast<const __m128i*>(node),
+                                                           masks + kBranching - from, masks + 2 * kBranching - to));
+    }
+
+    // Masked vectors [kBegin, kEnd) of a node combined pairwise: the recursion unrolls at compile time,
+    // and only one Combine per node waits for the accumulator
+    template <size_t kBegin, size_t kEnd, bool kFromMask, bool kToMask>
+    static __m128i CombineVectors(const __m128i* vectors, const int32_t* from_mask, const int32_t* to_mask) {
+        if constexpr (kEnd - kBegin == 1) {
+            const __m128i from = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from_mask + 4 * kBegin));
+            const __m128i to = _mm_loadu_si128(reinterpret_cast<const __m128i*>(to_mask + 4 * kBegin));
+            const __m128i mask = !kToMask ? from : !kFromMask ? to : _mm_and_si128(from, to);
+            return Combiner::Select(mask, _mm_load_si128(vectors + kBegin));
+        } else {
+            constexpr size_t kMiddle = (kBegin + kEnd) / 2;
+            return Combiner::Combine(CombineVectors<kBegin, kMiddle, kFromMask, kToMask>(vectors, from_mask, to_mask),
+                                     CombineVectors<kMiddle, kEnd, kFromMask, kToMask>(vectors, from_mask, to_mask));
+        }
+    }
+};
+#endif
+
+#ifdef WIDE_SEGMENT_TREE_DISPATCH
+// The same lanes eight wide. Builds without -mavx2 still compile them with the avx2 target attribute,
+// and the tree calls them only after HasAvx2() checked the CPU
+#define WIDE_SEGMENT_TREE_AVX2 __attribute__((target("avx2")))
+
+inline bool HasAvx2() {
+    static const bool has_avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    return has_avx2;
+}
+
+template <class Element, class Monoid>
+struct Avx2Combine {
+    static constexpr bool kSupported = false;
+};
+
+template <>
+struct Avx2Combine<int32_t, SumMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    WIDE_SEGMENT_TREE_AVX2 static __m256i Combine(__m256i lhs, __m256i rhs) {
+        return _mm256_add_epi32(lhs, rhs);
+    }
+
+    WIDE_SEGMENT_TREE_AVX2 static __m256i Select(__m256i mask, __m256i value) {
+        return _mm256_and_si256(mask, value);
+    }
+};
+
+template <>
+struct Avx2Combine<int32_t, MinMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    WIDE_SEGMENT_TREE_AVX2 static __m256i Combine(__m256i lhs, __m256i rhs) {
+        return _mm256_min_epi32(lhs, rhs);
+    }
+
+    WIDE_SEGMENT_TREE_AVX2 static __m256i Select(__m256i mask, __m256i value) {
+        return _mm256_blendv_epi8(_mm256_set1_epi32(MinMonoid<int32_t>::Neutral()), value, mask);
+    }
+};
+
+template <>
+struct Avx2Combine<int32_t, MaxMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    WIDE_SEGMENT_TREE_AVX2 static __m256i Combine(__m256i lhs, __m256i rhs) {
+        return _mm256_max_epi32(lhs, rhs);
+    }
+
+    WIDE_SEGMENT_TREE_AVX2 static __m256i Select(__m256i mask, __m256i value) {
+        return _mm256_blendv_epi8(_mm256_set1_epi32(MaxMonoid<int32_t>::Neutral()), value, mask);
+    }
+};
+
+template <class Element, class Monoid, size_t kBranching>
+class Avx2Lanes {
+public:
+    static constexpr bool kSupported = Avx2Combine<Element, Monoid>::kSupported && kBranching >= 8;
+
+    WIDE_SEGMENT_TREE_AVX2 Avx2Lanes() : accumulator_(_mm256_set1_epi32(Monoid::Neutral())) {
+    }
+
+    WIDE_SEGMENT_TREE_AVX2 void Accumulate(const Element* node, size_t from, size_t to) {
+        AccumulateMasked<true, true>(node, from, to);
+    }
+
+    WIDE_SEGMENT_TREE_AVX2 void AccumulateSuffix(const Element* node, size_t from) {
+        AccumulateMasked<true, false>(node, from, kBranching);
+    }
+
+    WIDE_SEGMENT_TREE_AVX2 void AccumulatePrefix(const Element* node, size_t to) {
+        AccumulateMasked<false, true>(node, 0, to);
+    }
+
+    WIDE_SEGMENT_TREE_AVX2 Element Result() const {
+        __m256i result = Combiner::Combine(accumulator_, _mm256_permute2x128_si256(accumulator_, accumulator_, 1));
+        result = Combiner::Combine(result, _mm256_shuffle_epi32(result, 0x4E));
+        result = Combiner::Combine(result, _mm256_shuffle_epi32(result, 0xB1));
+        return _mm256_cvtsi256_si32(result);
+    }
+
+private:
+    using Combiner = Avx2Combine<Element, Monoid>;
+
+    __m256i accumulator_;
+
+    template <bool kFromMask, bool kToMask>
+    WIDE_SEGMENT_TREE_AVX2 void AccumulateMasked(const Element* node, size_t from, size_t to) {
+        const int32_t* masks = LaneMasks<kBranching>::kTable.values;
+        accumulator_ = Combiner::Combine(accumulator_, CombineVectors<0, kBranching / 8, kFromMask, kToMask>(
+                                                           reinterpret_cast<const __m256i*>(node),
+                                                           masks + kBranching - from, masks + 2 * kBranching - to));
+    }
+
+    template <size_t kBegin, size_t kEnd, bool kFromMask, bool kToMask>
+    WIDE_SEGMENT_TREE_AVX2 static __m256i CombineVectors(const __m256i* vectors, const int32_t* from_mask,
+                                                         const int32_t* to_mask) {
+        if constexpr (kEnd - kBegin == 1) {
+            const __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from_mask + 8 * kBegin));
+            const __m256i to = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(to_mask + 8 * kBegin));
+            const __m256i mask = !kToMask ? from : !kFromMask ? to : _mm256_and_si256(from, to);
+            return Combiner::Select(mask, _mm256_load_si256(vectors + kBegin));
+        } else {
+            constexpr size_t kMiddle = (kBegin + kEnd) / 2;
+            return Combiner::Combine(CombineVectors<kBegin, kMiddle, kFromMask, kToMask>(vectors, from_mask, to_mask),
+                                     CombineVectors<kMiddle, kEnd, kFromMask, kToMask>(vectors, from_mask, to_mask));
+        }
+    }
+};
+
+// With AVX-512 a node of 16 int32 is one register and the lanes outside [from, to) are a bit mask:
+// every node is one masked Combine with the node read straight from memory. The masks are built
+// with the BMI2 shifts, one instruction each where a shift by a variable count takes three
+#define WIDE_SEGMENT_TREE_AVX512 __attribute__((target("avx512f,bmi2")))
+
+inline bool HasAvx512() {
+    static const bool has_avx512 =
+        (__builtin_cpu_init(), __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("bmi2"));
+    return has_avx512;
+}
+
+// MaskCombine combines the lanes of value set in mask into accumulator and keeps the others.
+// Only the masked intrinsics are used: GCC 12 warns about the undefined source of the plain ones
+template <class Element, class Monoid>
+struct Avx512Combine {
+    static constexpr bool kSupported = false;
+};
+
+template <>
+struct Avx512Combine<int32_t, SumMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    WIDE_SEGMENT_TREE_AVX512 static __m512i MaskCombine(__m512i accumulator, __mmask16 mask, __m512i value) {
+        return _mm512_mask_add_epi32(accumulator, mask, accumulator, value);
+    }
+};
+
+template <>
+struct Avx512Combine<int32_t, MinMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    WIDE_SEGMENT_TREE_AVX512 static __m512i MaskCombine(__m512i accumulator, __mmask16 mask, __m512i value) {
+        return _mm512_mask_min_epi32(accumulator, mask, accumulator, value);
+    }
+};
+
+template <>
+struct Avx512Combine<int32_t, MaxMonoid<int32_t>> {
+    static constexpr bool kSupported = true;
+
+    WIDE_SEGMENT_TREE_AVX512 static __m512i MaskCombine(__m512i accumulator, __mmask16 mask, __m512i value) {
+        return _mm512_mask_max_epi32(accumulator, mask, accumulator, value);
+    }
+};
+
+// Bit i of the node mask is lane i, so nodes of up to 64 lanes fit one 64-bit mask
+template <class Element, class Monoid, size_t kBranching>
+class Avx512Lanes {
+public:
+    static constexpr bool kSupported =
+        Avx512Combine<Element, Monoid>::kSupported && kBranching >= 16 && kBranching <= 64;
+
+    WIDE_SEGMENT_TREE_AVX512 Avx512Lanes() : accumulator_(_mm512_set1_epi32(Monoid::Neutral())) {
+    }
+
+    WIDE_SEGMENT_TREE_AVX512 void Accumulate(const Element* node, size_t from, size_t to) {
+        AccumulateMasked(node, SuffixMask(from) & PrefixMask(to));
+    }
+
+    WIDE_SEGMENT_TREE_AVX512 void AccumulateSuffix(const Element* node, size_t from) {
+        AccumulateMasked(node, SuffixMask(from));
+    }
+
+    WIDE_SEGMENT_TREE_AVX512 void AccumulatePrefix(const Element* node, size_t to) {
+        AccumulateMasked(node, PrefixMask(to));
+    }
+
+    WIDE_SEGMENT_TREE_AVX512 Element Result() const {
+        constexpr __mmask16 kAll = 0xFFFF;
+        __m512i result = accumulator_;
+        result = Combiner::MaskCombine(result, kAll, _mm512_mask_shuffle_i32x4(result, kAll, result, result, 0x4E));
+        result = Combiner::MaskCombine(result, kAll, _mm512_mask_shuffle_i32x4(result, kAll, result, result, 0xB1));
+        result = Combiner::MaskCombine(result, kAll, _mm512_mask_shuffle_epi32(result, kAll, result, _MM_PERM_BADC));
+        result = Combiner::MaskCombine(result, kAll, _mm512_mask_shuffle_epi32(result, kAll, result, _MM_PERM_CDAB));
+        return _mm512_cvtsi512_si32(result);
+    }
+
+private:
+    using Combiner = Avx512Combine<Element, Monoid>;
+
+    __m512i accumulator_;
+
+    WIDE_SEGMENT_TREE_AVX512 static uint64_t SuffixMask(size_t from) {
+        return ~uint64_t(0) << from;
+    }
+
+    // bzhi clears the bits from to on, to == 64 included
+    WIDE_SEGMENT_TREE_AVX512 static uint64_t PrefixMask(size_t to) {
+        return _bzhi_u64(~uint64_t(0), to);
+    }
+
+    WIDE_SEGMENT_TREE_AVX512 void AccumulateMasked(const Element* node, uint64_t mask) {
+        for (size_t i = 0; i < kBranching / 16; ++i) {
+            accumulator_ = Combiner::MaskCombine(accumulator_, __mmask16(mask >> (16 * i)),
+                                                 _mm512_load_si512(node + 16 * i));
+        }
+    }
+};
+#endif
+
+#ifdef __SSE2__
+template <class Element, class Monoid, size_t kBranching>
+using Lanes = std::conditional_t<SimdCombine<Element, Monoid>::kSupported, SimdLanes<Element, Monoid, kBranching>,
+                                 ScalarLanes<Element, Monoid, kBranching>>;
+#else
+template <class Element, class Monoid, size_t kBranching>
+using Lanes = ScalarLanes<Element, Monoid, kBranching>;
+#endif
+
+}  // namespace wide_segment_tree_details
+
+// Read-optimized alternative to SegmentTree with kBranching children per node, laid out as an S-tree:
+// level 0 holds the elements, element j of level k + 1 is the result over node j of level k, that is
+// elements [j * kBranching, (j + 1) * kBranching) of level k. All levels share one buffer, every node
+// is kBranching contiguous elements on a cache line boundary (one line for 16 int32), and memory is
+// n * kBranching / (kBranching - 1) elements.
+// A query climbs log_kBranching(n) levels and reads at most two nodes on each: the node holding left
+// and the node holding right - 1, masked to the part inside the range. For 32-bit integer sum, min
+// and max all nodes are combined lane-wise into one vector register, which is reduced once at the end:
+// AVX-512 or AVX2 when the CPU has them, SSE otherwise; other monoids combine lanes one by one.
+// At 10^8 elements the query is bound by how many queries fit the out-of-order window behind the cache
+// misses of level 0, so it pays to keep the instructions per level few.
+// Combining out of order needs a commutative Monoid (sum, min, max are).
+template <class Element, class Monoid, size_t kBranching = 16>
+class WideSegmentTree {
+public:
+    static_assert(kBranching >= 4 && (kBranching & (kBranching - 1)) == 0, "kBranching must be a power of two");
+
+    explicit WideSegmentTree(const std::vector<Element>& elems) : size_(elems.size()) {
+        size_t total = 0;
+        for (size_t level_size = RoundUp(size_);; level_size = RoundUp(level_size / kBranching)) {
+            level_begins_.push_back(total);
+            total += level_size;
+            if (level_size == kBranching) {
+                break;
+            }
+        }
+        level_begins_.push_back(total);
+
+        tree_.assign(total, Monoid::Neutral());
+        std::copy(elems.begin(), elems.end(), tree_.begin());
+        for (size_t level = 0; level + 2 < level_begins_.size(); ++level) {
+            for (size_t node = 0; node < LevelSize(level) / kBranching; ++node) {
+                Pull(level, node);
+            }
+        }
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    // Result of Monoid over [left, right)
+    Element Query(size_t left, size_t right) const {
+#ifdef WIDE_SEGMENT_TREE_DISPATCH
+        if constexpr (wide_segment_tree_details::Avx512Lanes<Element, Monoid, kBranching>::kSupported) {
+            if (wide_segment_tree_details::HasAvx512()) {
+                return QueryAvx512(left, right);
+            }
+        }
+        if constexpr (wide_segment_tree_details::Avx2Lanes<Element, Monoid, kBranching>::kSupported) {
+            if (wide_segment_tree_details::HasAvx2()) {
+                return QueryAvx2(left, right);
+            }
+        }
+#endif
+        return QueryWith<Lanes>(left, right);
+    }
+
+    Element Get(size_t index) const {
+        return tree_[index];
+    }
+
+    // Recombines one node per level, kBranching * log_kBranching(n) work
+    void Set(size_t index, const Element& value) {
+        tree_[index] = value;
+        for (size_t level = 0; level + 2 < level_begins_.size(); ++level) {
+            index /= kBranching;
+            Pull(level, index);
+        }
+    }
+
+    size_t MemoryBytes() const {
+        return tree_.capacity() * sizeof(Element);
+    }
+
+private:
+    using Lanes = wide_segment_tree_details::Lanes<Element, Monoid, kBranching>;
+
+    size_t size_;
+    // Level k is [level_begins_[k], level_begins_[k + 1]), the last level is one node
+    std::vector<size_t> level_begins_;
+    std::vector<Element, wide_segment_tree_details::CacheLineAllocator<Element>> tree_;
+
+    // Nodes are addressed by the index of their first lane, left and last rounded down to kBranching
+    template <class QueryLanes>
+    Element QueryWith(size_t left, size_t right) const {
+        QueryLanes lanes;
+        for (size_t level = 0; left < right; ++level) {
+            const Element* nodes = tree_.data() + level_begins_[level];
+            const size_t last = right - 1;
+            const Element* left_values = nodes + (left & ~(kBranching - 1));
+            if (left / kBranching == last / kBranching) {
+                lanes.Accumulate(left_values, left % kBranching, last % kBranching + 1);
+                break;
+            }
+            lanes.AccumulateSuffix(left_values, left % kBranching);
+            lanes.AccumulatePrefix(nodes + (last & ~(kBranching - 1)), last % kBranching + 1);
+            left = left / kBranching + 1;
+            right = last / kBranching;
+        }
+        return lanes.Result();
+    }
+
+#ifdef WIDE_SEGMENT_TREE_DISPATCH
+    // flatten inlines QueryWith and the lanes into these functions, so the whole walk is compiled
+    // for the instruction set of the lanes
+    __attribute__((target("avx2"), flatten)) Element QueryAvx2(size_t left, size_t right) const {
+        return QueryWith<wide_segment_tree_details::Avx2Lanes<Element, Monoid, kBranching>>(left, right);
+    }
+
+    __attribute__((target("avx512f,bmi2"), flatten)) Element QueryAvx512(size_t left, size_t right) const {
+        return QueryWith<wide_segment_tree_details::Avx512Lanes<Element, Monoid, kBranching>>(left, right);
+    }
+#endif
+
+    static size_t RoundUp(size_t size) {
+        return (std::max<size_t>(size, 1) + kBranching - 1) / kBranching * kBranching;
+    }
+
+    size_t LevelSize(size_t level) const {
+        return level_begins_[level + 1] - level_begins_[level];
+    }
+
+    // Element node of level + 1 becomes the result over node node of level
+    void Pull(size_t level, size_t node) {
+        const Element* values = tree_.data() + level_begins_[level] + node * kBranching;
+        Lanes lanes;
+        lanes.Accumulate(values, 0, kBranching);
+        tree_[level_begins_[level + 1] + node] = lanes.Result();
+    }
+};
+
+#endif
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+#include "k_merge.h"
+
+// Best effort for files abandoned on errors, written files are closed by CloseFile
+struct FileCloser {
+    void operator()(FILE* file) const {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+};
+
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+FilePtr OpenFile(const std::string& path, const char* mode) {
+    FilePtr file(std::fopen(path.c_str(), mode));
+    if (!file) {
+        throw std::runtime_error("Can not open file " + path);
+    }
+    return file;
+}
+
+// fclose flushes the stdio buffer, so a full disk may only show up here
+void CloseFile(FilePtr file) {
+    if (std::fclose(file.release()) != 0) {
+        throw std::runtime_error("Write failed");
+    }
+}
+
+// Reads a file block by block, the next block is loaded in background while the current one is consumed
+template <class T>
+class PrefetchingReader {
+public:
+    PrefetchingReader(const std::string& path, size_t buffer_size)
+        : file_(OpenFile(path, "rb")), current_(buffer_size), next_(buffer_size) {
+        current_.resize(std::fread(current_.data(), sizeof(T), current_.size(), file_.get()));
+        Prefetch();
+    }
+
+    PrefetchingReader(PrefetchingReader&&) = default;
+
+    ~PrefetchingReader() {
+        if (pending_.valid()) {
+            pending_.wait();
+        }
+    }
+
+    bool Next(T& value) {
+        if (position_ == current_.size()) {
+            if (current_.empty()) {
+                return false;
+            }
+            next_.resize(pending_.get());
+            current_.swap(next_);
+            position_ = 0;
+            if (current_.empty()) {
+                return false;
+            }
+            Prefetch();
+        }
+        value = current_[position_++];
+        return true;
+    }
+
+private:
+    void Prefetch() {
+        next_.resize(current_.capacity());
+        pending_ = std::async(std::launch::async, [file = file_.get(), buffer = next_.data(), size = next_.size()]() {
+            return std::fread(buffer, sizeof(T), size, file);
+        });
+    }
+
+    FilePtr file_;
+    std::vector<T> current_;
+    std::vector<T> next_;
+    size_t position_ = 0;
+    std::future<size_t> pending_;
+};
+
+// Input iterator over the elements of a PrefetchingReader, so runs can feed the k_merge.h loser tree.
+// The default constructed iterator is the end of any run.
+template <class T>
+class RunIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    RunIterator() = default;
+
+    explicit RunIterator(PrefetchingReader<T>* reader) : reader_(reader) {
+        ++*this;
+    }
+
+    const T& operator*() const {
+        return value_;
+    }
+
+    RunIterator& operator++() {
+        if (!reader_->Next(value_)) {
+            reader_ = nullptr;
+        }
+        return *this;
+    }
+
+    bool operator==(const RunIterator& other) const {
+        return reader_ == other.reader_;
+    }
+
+    bool operator!=(const RunIterator& other) const {
+        return reader_ != other.reader_;
+    }
+
+private:
+    PrefetchingReader<T>* reader_ = nullptr;
+    T value_{};
+};
+
+template <class T>
+class BufferedWriter {
+public:
+    BufferedWriter(const std::string& path, size_t buffer_size) : file_(OpenFile(path, "wb")) {
+        buffer_.reserve(buffer_size);
+    }
+
+    // A writer that was not closed is being abandoned, usually while an error unwinds: what is
+    // buffered is written if possible, and nothing is reported
+    ~BufferedWriter() {
+        if (file_) {
+            std::fwrite(buffer_.data(), sizeof(T), buffer_.size(), file_.get());
+        }
+    }
+
+    void Write(const T& value) {
+        buffer_.push_back(value);
+        if (buffer_.size() == buffer_.capacity()) {
+            Flush();
+        }
+    }
+
+    void Flush() {
+        if (std::fwrite(buffer_.data(), sizeof(T), buffer_.size(), file_.get()) != buffer_.size()) {
+            throw std::runtime_error("Write failed");
+        }
+        buffer_.clear();
+    }
+
+    void Close() {
+        Flush();
+        CloseFile(std::move(file_));
+    }
+
+private:
+    FilePtr file_;
+    std::vector<T> buffer_;
+};
+
+class TempFiles {
+public:
+    TempFiles() : directory_(std::filesystem::temp_directory_path()) {
+    }
+
+    ~TempFiles() {
+        for (const auto& path : paths_) {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+    }
+
+    std::string Create() {
+        // The pid keeps processes sharing the temp directory apart, the address keeps sorts inside one process apart
+        std::string path = (directory_ / ("external_sort_" + std::to_string(getpid()) + "_" +
+                                          std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" +
+                                          std::to_string(paths_.size()) + ".run")).string();
+        paths_.push_back(path);
+        return path;
+    }
+
+    void Remove(const std::string& path) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+
+private:
+    std::filesystem::path directory_;
+    std::vector<std::string> paths_;
+};
+
+const size_t kMinBufferSize = 1 << 12;
+
+template <class T, class Cmp>
+void MergeRuns(const std::vector<std::string>& runs, const std::string& output, size_t buffer_size, Cmp cmp) {
+    std::vector<PrefetchingReader<T>> readers;
+    readers.reserve(runs.size());
+    std::vector<RunIterator<T>> begins, ends(runs.size());
+    for (const auto& run : runs) {
+        readers.emplace_back(run, buffer_size);
+        begins.emplace_back(&readers.back());
+    }
+
+    LoserTree<RunIterator<T>, Cmp, true> tree(begins, ends, cmp);
+    BufferedWriter<T> writer(output, buffer_size);
+    while (!tree.Empty()) {
+        writer.Write(tree.Top());
+        tree.Pop();
+    }
+    writer.Close();
+}
+
+// Sorts a binary file of T using about memory_budget bytes of RAM, returns the number of elements
+template <class T, class Cmp = std::less<T>>
+uint64_t ExternalSort(const std::string& input, const std::string& output, size_t memory_budget, Cmp cmp = Cmp()) {
+    static_assert(std::is_trivially_copyable<T>::value, "ExternalSort stores raw elements in files");
+    TempFiles temp_files;
+    std::vector<std::string> runs;
+    uint64_t total_size = 0;
+
+    // Phase 1: sorted runs of budget size
+    {
+        std::vector<T> chunk(std::max<size_t>(memory_budget / sizeof(T), 1));
+        FilePtr file = OpenFile(input, "rb");
+        size_t read;
+        while ((read = std::fread(chunk.data(), sizeof(T), chunk.size(), file.get())) > 0) {
+            std::sort(chunk.begin(), chunk.begin() + read, cmp);
+            runs.push_back(temp_files.Create());
+            FilePtr run = OpenFile(runs.back(), "wb");
+            if (std::fwrite(chunk.data(), sizeof(T), read, run.get()) != read) {
+                throw std::runtime_error("Write failed");
+            }
+            CloseFile(std::move(run));
+            total_size += read;
+        }
+    }
+
+    if (runs.empty()) {
+        CloseFile(OpenFile(output, "wb"));
+        return 0;
+    }
+
+    // Phase 2: every reader holds two buffers, so fan-in is limited by the budget
+    const size_t max_fan_in = std::max<size_t>(memory_budget / (2 * kMinBufferSize * sizeof(T)), 3) - 1;
+    while (runs.size() > max_fan_in) {
+        std::vector<std::string> merged;
+        for (size_t begin = 0; begin < runs.size(); begin += max_fan_in) {
+            size_t end = std::min(runs.size(), begin + max_fan_in);
+            std::vector<std::string> group(runs.begin() + begin, runs.begin() + end);
+            merged.push_back(temp_files.Create());
+            const size_t buffer_size = std::max<size_t>(memory_budget / (2 * (group.size() + 1) * sizeof(T)), 1);
+            MergeRuns<T>(group, merged.back(), buffer_size, cmp);
+            for (const auto& run : group) {
+                temp_files.Remove(run);
+            }
+        }
+        runs.swap(merged);
+    }
+
+    const size_t buffer_size = std::max(memory_budget / (2 * (runs.size() + 1) * sizeof(T)), kMinBufferSize);
+    MergeRuns<T>(runs, output, buffer_size, cmp);
+    return total_size;
+}
+
+int main() {
+    std::string input, output;
+    size_t memory_budget_mb;
+    std::cin >> input >> output >> memory_budget_mb;
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t elements;
+    try {
+        elements = ExternalSort<int64_t>(input, output, memory_budget_mb << 20);
+    } catch (const std::runtime_error& error) {
+        std::cout << error.what() << '\n';
+        return 1;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double megabytes = static_cast<double>(elements * sizeof(int64_t)) / (1 << 20);
+    std::cout << "Sorted " << elements << " elements in " << elapsed.count() << " s, "
+              << megabytes / std::max(elapsed.count(), 1e-9) << " MB/s\n";
+
+    return 0;
+}
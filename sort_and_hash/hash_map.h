@@ -0,0 +1,242 @@
+#ifndef SORT_AND_HASH_HASH_MAP_H
+#define SORT_AND_HASH_HASH_MAP_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Control bytes of one probing group, compared against a byte all at once
+class ControlGroup {
+public:
+    static constexpr size_t kWidth = 16;
+
+    explicit ControlGroup(const uint8_t* control) {
+#ifdef __SSE2__
+        bytes_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+        control_ = control;
+#endif
+    }
+
+    // Bit i is set when byte i equals value
+    uint32_t Match(uint8_t value) const {
+#ifdef __SSE2__
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes_, _mm_set1_epi8(static_cast<char>(value))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(control_[i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+
+private:
+#ifdef __SSE2__
+    __m128i bytes_;
+#else
+    const uint8_t* control_;
+#endif
+};
+
+// Open addressing map with linear probing, scanned a group of control bytes at a time.
+// A control byte is kEmpty or the 7 low bits of the hash of the slot key.
+// Erase shifts the following entries back, so there are no tombstones and probe chains never rot.
+template <class K, class V, class Hash = std::hash<K>, class Equal = std::equal_to<K>>
+class HashMap {
+public:
+    HashMap(Hash hash = Hash(), Equal equal = Equal()) : hash_(hash), equal_(equal) {
+        Rehash(kMinCapacity);
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    size_t Capacity() const {
+        return slots_.size();
+    }
+
+    // Makes room for count elements without further rehashing
+    void Reserve(size_t count) {
+        size_t capacity = kMinCapacity;
+        while (count * kMaxLoadDenominator > capacity * kMaxLoadNumerator) {
+            capacity *= 2;
+        }
+        if (capacity > Capacity()) {
+            Rehash(capacity);
+        }
+    }
+
+    // capacity is rounded up to a power of two that fits all elements
+    void Rehash(size_t capacity) {
+        size_t new_capacity = kMinCapacity;
+        while (new_capacity < capacity || size_ * kMaxLoadDenominator > new_capacity * kMaxLoadNumerator) {
+            new_capacity *= 2;
+        }
+
+        std::vector<std::pair<K, V>> old_slots(new_capacity);
+        std::vector<uint8_t> old_control(new_capacity + ControlGroup::kWidth - 1, kEmpty);
+        old_slots.swap(slots_);
+        old_control.swap(control_);
+        mask_ = new_capacity - 1;
+        size_ = 0;
+
+        for (size_t i = 0; i + ControlGroup::kWidth - 1 < old_control.size(); ++i) {
+            if (old_control[i] != kEmpty) {
+                InsertNew(HashOf(old_slots[i].first), std::move(old_slots[i]));
+            }
+        }
+    }
+
+    V* Find(const K& key) {
+        const size_t slot = FindSlot(key, HashOf(key));
+        return slot == kNotFound ? nullptr : &slots_[slot].second;
+    }
+
+    const V* Find(const K& key) const {
+        const size_t slot = FindSlot(key, HashOf(key));
+        return slot == kNotFound ? nullptr : &slots_[slot].second;
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != nullptr;
+    }
+
+    // Returns false if the key is already present, its value stays untouched then
+    bool Insert(const K& key, const V& value) {
+        const size_t hash = HashOf(key);
+        if (FindSlot(key, hash) != kNotFound) {
+            return false;
+        }
+        GrowIfNeeded();
+        InsertNew(hash, std::make_pair(key, value));
+        return true;
+    }
+
+    V& operator[](const K& key) {
+        const size_t hash = HashOf(key);
+        size_t slot = FindSlot(key, hash);
+        if (slot == kNotFound) {
+            GrowIfNeeded();
+            slot = InsertNew(hash, std::make_pair(key, V()));
+        }
+        return slots_[slot].second;
+    }
+
+    bool Erase(const K& key) {
+        size_t hole = FindSlot(key, HashOf(key));
+        if (hole == kNotFound) {
+            return false;
+        }
+
+        // Pull back every following entry whose home slot is not between the hole and itself
+        for (size_t next = (hole + 1) & mask_; control_[next] != kEmpty; next = (next + 1) & mask_) {
+            const size_t home = HomeSlot(HashOf(slots_[next].first));
+            if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                slots_[hole] = std::move(slots_[next]);
+                SetControl(hole, control_[next]);
+                hole = next;
+            }
+        }
+        slots_[hole] = std::pair<K, V>();
+        SetControl(hole, kEmpty);
+        --size_;
+        return true;
+    }
+
+    template <class Function>
+    void ForEach(Function function) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (control_[i] != kEmpty) {
+                function(slots_[i].first, slots_[i].second);
+            }
+        }
+    }
+
+private:
+    static constexpr uint8_t kEmpty = 0x80;
+    static constexpr size_t kMinCapacity = ControlGroup::kWidth;
+    static constexpr size_t kMaxLoadNumerator = 7;
+    static constexpr size_t kMaxLoadDenominator = 8;
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+    static constexpr uint64_t kMixMultiplier = 0x9e3779b97f4a7c15ULL;
+
+    // Hashes modulo a prime never fill the high bits, so the value is mixed before use
+    size_t HashOf(const K& key) const {
+        uint64_t hash = static_cast<uint64_t>(hash_(key)) * kMixMultiplier;
+        return hash ^ (hash >> 32);
+    }
+
+    size_t HomeSlot(size_t hash) const {
+        return (hash >> 7) & mask_;
+    }
+
+    static uint8_t ControlByte(size_t hash) {
+        return hash & 0x7f;
+    }
+
+    // The first kWidth - 1 control bytes are mirrored after the end, so a group load never wraps
+    void SetControl(size_t slot, uint8_t value) {
+        control_[slot] = value;
+        if (slot < ControlGroup::kWidth - 1) {
+            control_[slots_.size() + slot] = value;
+        }
+    }
+
+    size_t FindSlot(const K& key, size_t hash) const {
+        const uint8_t control_byte = ControlByte(hash);
+        size_t position = HomeSlot(hash);
+        while (true) {
+            ControlGroup group(&control_[position]);
+            for (uint32_t match = group.Match(control_byte); match != 0; match &= match - 1) {
+                const size_t slot = (position + __builtin_ctz(match)) & mask_;
+                if (equal_(slots_[slot].first, key)) {
+                    return slot;
+                }
+            }
+            if (group.Match(kEmpty) != 0) {
+                return kNotFound;
+            }
+            position = (position + ControlGroup::kWidth) & mask_;
+        }
+    }
+
+    size_t InsertNew(size_t hash, std::pair<K, V>&& entry) {
+        size_t position = HomeSlot(hash);
+        while (true) {
+            const uint32_t empty = ControlGroup(&control_[position]).Match(kEmpty);
+            if (empty != 0) {
+                const size_t slot = (position + __builtin_ctz(empty)) & mask_;
+                slots_[slot] = std::move(entry);
+                SetControl(slot, ControlByte(hash));
+                ++size_;
+                return slot;
+            }
+            position = (position + ControlGroup::kWidth) & mask_;
+        }
+    }
+
+    void GrowIfNeeded() {
+        if ((size_ + 1) * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator) {
+            Rehash(slots_.size() * 2);
+        }
+    }
+
+    std::vector<std::pair<K, V>> slots_;
+    std::vector<uint8_t> control_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    Hash hash_;
+    Equal equal_;
+};
+
+#endif
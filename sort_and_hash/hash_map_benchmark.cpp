@@ -0,0 +1,100 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "hash_map.h"
+#include "string_hash.h"
+#include "universal_hash_function.h"
+
+// Inserts all keys, looks up every key and one miss per key, then erases half of them
+template <class Map, class Key>
+void RunWorkload(const std::string& name, Map& map, const std::vector<Key>& keys, const std::vector<Key>& misses) {
+    size_t checksum = 0;
+    double insert_time = MeasureSeconds([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            map[keys[i]] = i;
+        }
+    });
+    double find_time = MeasureSeconds([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            checksum += map.count(keys[i]) + map.count(misses[i]);
+        }
+    });
+    double erase_time = MeasureSeconds([&]() {
+        for (size_t i = 0; i < keys.size(); i += 2) {
+            map.erase(keys[i]);
+        }
+    });
+    std::cout << name << "\tinsert " << insert_time << " s\tfind " << find_time
+              << " s\terase " << erase_time << " s\t(" << checksum << ")\n";
+}
+
+// std::unordered_map-like facade, so both maps run the same workload
+template <class K, class V, class Hash>
+class HashMapAdapter {
+public:
+    explicit HashMapAdapter(Hash hash) : map_(hash) {
+    }
+
+    V& operator[](const K& key) {
+        return map_[key];
+    }
+
+    size_t count(const K& key) const {
+        return map_.Contains(key) ? 1 : 0;
+    }
+
+    void erase(const K& key) {
+        map_.Erase(key);
+    }
+
+private:
+    HashMap<K, V, Hash> map_;
+};
+
+std::string RandomString(std::mt19937& generator, size_t length) {
+    std::uniform_int_distribution<int> distr('a', 'z');
+    std::string result(length, ' ');
+    for (auto& symb : result) {
+        symb = distr(generator);
+    }
+    return result;
+}
+
+int main() {
+    size_t keys_number;
+    std::cin >> keys_number;
+
+    std::mt19937 generator;
+    std::vector<std::string> string_keys(keys_number), string_misses(keys_number);
+    std::vector<int> int_keys(keys_number), int_misses(keys_number);
+    std::uniform_int_distribution<int> distr(0, 1 << 30);
+    for (size_t i = 0; i < keys_number; ++i) {
+        string_keys[i] = RandomString(generator, 16);
+        string_misses[i] = RandomString(generator, 17);
+        int_keys[i] = 2 * distr(generator);
+        int_misses[i] = 2 * distr(generator) + 1;
+    }
+
+    {
+        std::unordered_map<std::string, size_t, StringHash> map;
+        RunWorkload("unordered_map<string>", map, string_keys, string_misses);
+    }
+    {
+        HashMapAdapter<std::string, size_t, StringHash> map(StringHash(42));
+        RunWorkload("HashMap<string>", map, string_keys, string_misses);
+    }
+    HashFunction int_hash = HashFunction::MakeHash(generator);
+    {
+        std::unordered_map<int, size_t, HashFunction> map(0, int_hash);
+        RunWorkload("unordered_map<int>", map, int_keys, int_misses);
+    }
+    {
+        HashMapAdapter<int, size_t, HashFunction> map(int_hash);
+        RunWorkload("HashMap<int>", map, int_keys, int_misses);
+    }
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+#ifndef SORT_AND_HASH_K_MERGE_H
+#define SORT_AND_HASH_K_MERGE_H
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Tournament tree over k sorted sequences, every node keeps the loser of its match.
+// The general version compares through iterators, so keys are never copied.
+template <class Iterator, class Cmp, bool kCacheKeys>
+class LoserTree {
+public:
+    LoserTree(const std::vector<Iterator>& begins, const std::vector<Iterator>& ends, Cmp cmp)
+        : size_(begins.size()), losers_(begins.size()), heads_(begins), ends_(ends), cmp_(cmp) {
+        if (size_ > 0) {
+            losers_[0] = BuildSubtree(1);
+        }
+    }
+
+    bool Empty() const {
+        return size_ == 0 || Exhausted(losers_[0]);
+    }
+
+    const typename std::iterator_traits<Iterator>::value_type& Top() const {
+        return *heads_[losers_[0]];
+    }
+
+    void Pop() {
+        ++heads_[losers_[0]];
+        Replay();
+    }
+
+private:
+    bool Exhausted(size_t source) const {
+        return heads_[source] == ends_[source];
+    }
+
+    // Ties go to the smaller source index, which keeps the merge stable
+    bool Beats(size_t lhs, size_t rhs) const {
+        if (Exhausted(lhs) || Exhausted(rhs)) {
+            return !Exhausted(lhs);
+        }
+        if (cmp_(*heads_[lhs], *heads_[rhs])) {
+            return true;
+        }
+        return !cmp_(*heads_[rhs], *heads_[lhs]) && lhs < rhs;
+    }
+
+    size_t BuildSubtree(size_t node) {
+        if (node >= size_) {
+            return node - size_;
+        }
+        size_t left = BuildSubtree(2 * node);
+        size_t right = BuildSubtree(2 * node + 1);
+        if (Beats(left, right)) {
+            losers_[node] = right;
+            return left;
+        }
+        losers_[node] = left;
+        return right;
+    }
+
+    void Replay() {
+        size_t winner = losers_[0];
+        for (size_t node = (winner + size_) / 2; node > 0; node /= 2) {
+            if (Beats(losers_[node], winner)) {
+                std::swap(losers_[node], winner);
+            }
+        }
+        losers_[0] = winner;
+    }
+
+    size_t size_;
+    std::vector<size_t> losers_;
+    std::vector<Iterator> heads_;
+    std::vector<Iterator> ends_;
+    Cmp cmp_;
+};
+
+// For trivially copyable keys every node stores the loser key itself,
+// so a replay walks one contiguous array instead of dereferencing k heads.
+// Sources that are empty from the start are dropped, and an exhausted source keeps its last key,
+// so ValueType only has to be copyable.
+template <class Iterator, class Cmp>
+class LoserTree<Iterator, Cmp, true> {
+public:
+    using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+    LoserTree(const std::vector<Iterator>& begins, const std::vector<Iterator>& ends, Cmp cmp) : cmp_(cmp) {
+        for (size_t i = 0; i < begins.size(); ++i) {
+            if (begins[i] != ends[i]) {
+                heads_.push_back(begins[i]);
+                ends_.push_back(ends[i]);
+            }
+        }
+        size_ = heads_.size();
+        if (size_ > 0) {
+            nodes_.assign(size_, Entry{*heads_[0], 0, false});
+            nodes_[0] = BuildSubtree(1);
+        }
+    }
+
+    bool Empty() const {
+        return size_ == 0 || nodes_[0].exhausted;
+    }
+
+    const ValueType& Top() const {
+        return nodes_[0].key;
+    }
+
+    void Pop() {
+        Entry winner = nodes_[0];
+        if (++heads_[winner.source] == ends_[winner.source]) {
+            winner.exhausted = true;
+        } else {
+            winner.key = *heads_[winner.source];
+        }
+        for (size_t node = (winner.source + size_) / 2; node > 0; node /= 2) {
+            if (Beats(nodes_[node], winner)) {
+                std::swap(nodes_[node], winner);
+            }
+        }
+        nodes_[0] = winner;
+    }
+
+private:
+    struct Entry {
+        ValueType key;
+        size_t source;
+        bool exhausted;
+    };
+
+    bool Beats(const Entry& lhs, const Entry& rhs) const {
+        if (lhs.exhausted || rhs.exhausted) {
+            return !lhs.exhausted;
+        }
+        if (cmp_(lhs.key, rhs.key)) {
+            return true;
+        }
+        return !cmp_(rhs.key, lhs.key) && lhs.source < rhs.source;
+    }
+
+    Entry BuildSubtree(size_t node) {
+        if (node >= size_) {
+            return {*heads_[node - size_], node - size_, false};
+        }
+        Entry left = BuildSubtree(2 * node);
+        Entry right = BuildSubtree(2 * node + 1);
+        if (Beats(left, right)) {
+            nodes_[node] = right;
+            return left;
+        }
+        nodes_[node] = left;
+        return right;
+    }
+
+    size_t size_;
+    std::vector<Entry> nodes_;
+    std::vector<Iterator> heads_;
+    std::vector<Iterator> ends_;
+    Cmp cmp_;
+};
+
+template <class T>
+size_t FinalSize(const std::vector<std::vector<T>>& array) {
+    size_t final_size = 0;
+    for (size_t i = 0; i < array.size(); ++i) {
+        final_size += array[i].size();
+    }
+    return final_size;
+}
+
+// Single pass k-way merge, each output element costs log k comparisons
+template <class T, class Cmp = std::less<T>>
+std::vector<T> KMerge(const std::vector<std::vector<T>>& array, Cmp cmp = Cmp()) {
+    using Iterator = typename std::vector<T>::const_iterator;
+    std::vector<T> final;
+    if (array.empty()) {
+        return final;
+    }
+    final.reserve(FinalSize(array));
+
+    std::vector<Iterator> begins, ends;
+    for (const auto& run : array) {
+        begins.push_back(run.begin());
+        ends.push_back(run.end());
+    }
+
+    LoserTree<Iterator, Cmp, std::is_trivially_copyable<T>::value> tree(begins, ends, cmp);
+    while (!tree.Empty()) {
+        final.push_back(tree.Top());
+        tree.Pop();
+    }
+    return final;
+}
+
+#endif
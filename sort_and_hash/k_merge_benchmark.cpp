@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "k_merge.h"
+
+// The previous pairwise scheme, kept as the baseline
+template <class T>
+std::vector<T> KMergePairwise(std::vector<std::vector<T>> array) {
+    std::vector<T> tmp(FinalSize(array));
+
+    for (size_t k = 1; k < array.size(); k *= 2) {
+        for (size_t left = 0; left + k < array.size(); left += 2 * k) {
+            auto end = std::merge(array[left].begin(), array[left].end(),
+                                  array[left + k].begin(), array[left + k].end(), tmp.begin());
+            array[left].assign(tmp.begin(), end);
+        }
+    }
+
+    return array[0];
+}
+
+int main() {
+    size_t total_size;
+    std::cin >> total_size;
+
+    std::mt19937 generator;
+    std::uniform_int_distribution<int> distr;
+
+    std::cout << "k\tloser_tree_s\tpairwise_s\n";
+    for (size_t k = 2; k <= 1024; k *= 2) {
+        std::vector<std::vector<int>> array(k);
+        for (size_t i = 0; i < total_size; ++i) {
+            array[i % k].push_back(distr(generator));
+        }
+        for (auto& run : array) {
+            std::sort(run.begin(), run.end());
+        }
+
+        std::vector<int> tree_result, pairwise_result;
+        double tree_time = MeasureSeconds([&]() { tree_result = KMerge(array); });
+        double pairwise_time = MeasureSeconds([&]() { pairwise_result = KMergePairwise(array); });
+        if (tree_result != pairwise_result) {
+            std::cerr << "Results differ for k = " << k << '\n';
+            return 1;
+        }
+        std::cout << k << '\t' << tree_time << '\t' << pairwise_time << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#ifndef SORT_AND_HASH_MULTIPLY_SHIFT_HASH_FUNCTION_H
+#define SORT_AND_HASH_MULTIPLY_SHIFT_HASH_FUNCTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+
+// Drop-in alternative to HashFunction for integral keys up to 32 bits: Dietzfelbinger
+// multiply-add-shift, (a * x + b) mod 2^64 taken from the high 32 bits. It is 2-independent,
+// has no division and the bulk loop vectorizes.
+template <class T>
+class MultiplyShiftHashFunction {
+public:
+    static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(uint32_t), "Keys must fit in 32 bits");
+
+    MultiplyShiftHashFunction() = default;
+
+    MultiplyShiftHashFunction(uint64_t addend, uint64_t multiplier) : addend_(addend), multiplier_(multiplier) {
+    }
+
+    size_t operator()(const T& value) const {
+        return (static_cast<uint32_t>(value) * multiplier_ + addend_) >> kShift;
+    }
+
+    template <class Iterator>
+    void HashMany(Iterator keys, size_t count, size_t* out) const {
+        const uint64_t addend = addend_;
+        const uint64_t multiplier = multiplier_;
+        for (size_t i = 0; i < count; ++i, ++keys) {
+            out[i] = (static_cast<uint32_t>(*keys) * multiplier + addend) >> kShift;
+        }
+    }
+
+    template <class Generator>
+    static MultiplyShiftHashFunction MakeHash(Generator& generator) {
+        std::uniform_int_distribution<uint64_t> distr;
+        return MultiplyShiftHashFunction(distr(generator), distr(generator));
+    }
+
+private:
+    static constexpr size_t kShift = 32;
+    uint64_t addend_ = 0x9e3779b97f4a7c15ULL;
+    uint64_t multiplier_ = 0xc6a4a7935bd1e995ULL;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+struct Person {
+    std::string surname_;
+    std::string name_;
+    int points_;
+};
+
+struct Identity {
+    template <class T>
+    const T& operator()(const T& value) const {
+        return value;
+    }
+};
+
+// Maps signed keys to unsigned ones preserving the order
+template <class Key>
+typename std::make_unsigned<Key>::type ToUnsignedKey(Key key) {
+    using UnsignedKey = typename std::make_unsigned<Key>::type;
+    UnsignedKey result = static_cast<UnsignedKey>(key);
+    if (std::is_signed<Key>::value) {
+        result ^= UnsignedKey(1) << (sizeof(Key) * 8 - 1);
+    }
+    return result;
+}
+
+const size_t kRadixBits = 8;
+const size_t kRadix = 1 << kRadixBits;
+const size_t kMinParallelSize = 1 << 16;
+
+template <size_t KeyBytes>
+using Histograms = std::array<std::array<size_t, kRadix>, KeyBytes>;
+
+// Counts all digits of all keys in one pass, so each scatter pass only reads histograms
+template <size_t KeyBytes, class It, class KeyOf>
+void CountDigits(It begin, It end, KeyOf key_of, Histograms<KeyBytes>& histograms) {
+    for (auto& histogram : histograms) {
+        histogram.fill(0);
+    }
+    for (It it = begin; it != end; ++it) {
+        const auto key = ToUnsignedKey(key_of(*it));
+        for (size_t byte = 0; byte < KeyBytes; ++byte) {
+            ++histograms[byte][(key >> (byte * kRadixBits)) & (kRadix - 1)];
+        }
+    }
+}
+
+template <size_t KeyBytes, class It, class KeyOf>
+void CountDigitsParallel(It begin, It end, KeyOf key_of, Histograms<KeyBytes>& histograms, size_t threads_number) {
+    const size_t size = end - begin;
+    if (threads_number <= 1 || size < kMinParallelSize) {
+        CountDigits<KeyBytes>(begin, end, key_of, histograms);
+        return;
+    }
+
+    std::vector<Histograms<KeyBytes>> partial(threads_number);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_number; ++i) {
+        It part_begin = begin + size * i / threads_number;
+        It part_end = begin + size * (i + 1) / threads_number;
+        threads.emplace_back([part_begin, part_end, key_of, &partial, i]() {
+            CountDigits<KeyBytes>(part_begin, part_end, key_of, partial[i]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& histogram : histograms) {
+        histogram.fill(0);
+    }
+    for (const auto& part : partial) {
+        for (size_t byte = 0; byte < KeyBytes; ++byte) {
+            for (size_t digit = 0; digit < kRadix; ++digit) {
+                histograms[byte][digit] += part[byte][digit];
+            }
+        }
+    }
+}
+
+// Stable LSD sort by an integral key; threads_number > 1 parallelizes the histogram phase
+template <class It, class KeyOf = Identity>
+void LsdRadixSort(It begin, It end, KeyOf key_of = KeyOf(), size_t threads_number = 1) {
+    using ValueType = typename std::iterator_traits<It>::value_type;
+    using Key = typename std::decay<decltype(key_of(*begin))>::type;
+    static_assert(std::is_integral<Key>::value, "LsdRadixSort requires an integral key");
+    const size_t kKeyBytes = sizeof(Key);
+
+    const size_t size = end - begin;
+    if (size <= 1) {
+        return;
+    }
+
+    Histograms<kKeyBytes> histograms;
+    CountDigitsParallel<kKeyBytes>(begin, end, key_of, histograms, threads_number);
+
+    std::vector<ValueType> source(std::make_move_iterator(begin), std::make_move_iterator(end));
+    std::vector<ValueType> target(size);
+
+    for (size_t byte = 0; byte < kKeyBytes; ++byte) {
+        std::array<size_t, kRadix>& histogram = histograms[byte];
+        const size_t shift = byte * kRadixBits;
+
+        // All keys share this digit, the pass would not change the order
+        if (histogram[(ToUnsignedKey(key_of(source[0])) >> shift) & (kRadix - 1)] == size) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t digit = 0; digit < kRadix; ++digit) {
+            const size_t count = histogram[digit];
+            histogram[digit] = offset;
+            offset += count;
+        }
+
+        for (auto& elem : source) {
+            const size_t digit = (ToUnsignedKey(key_of(elem)) >> shift) & (kRadix - 1);
+            target[histogram[digit]++] = std::move(elem);
+        }
+        source.swap(target);
+    }
+
+    std::move(source.begin(), source.end(), begin);
+}
+
+// Byte at position depth, strings that ended earlier get digit 0 and go first
+inline size_t StringDigit(const std::string& value, size_t depth) {
+    return depth < value.size() ? static_cast<unsigned char>(value[depth]) + 1 : 0;
+}
+
+const size_t kStringRadix = kRadix + 1;
+const size_t kMsdInsertionThreshold = 32;
+
+// Strings sharing a long prefix go one level deeper per common character, so buckets wait on an
+// explicit stack instead of the call stack, and one pair of count arrays serves all levels
+template <class It>
+void MsdRadixSort(It begin, It end) {
+    struct Bucket {
+        It begin;
+        It end;
+        size_t depth;
+    };
+
+    std::vector<std::string> tmp(end - begin);
+    std::array<size_t, kStringRadix + 1> offsets;
+    std::array<size_t, kStringRadix + 1> bounds;
+    std::vector<Bucket> buckets = {{begin, end, 0}};
+    while (!buckets.empty()) {
+        const Bucket bucket = buckets.back();
+        buckets.pop_back();
+        const size_t size = bucket.end - bucket.begin;
+        const size_t depth = bucket.depth;
+        if (size <= kMsdInsertionThreshold) {
+            std::sort(bucket.begin, bucket.end, [depth](const std::string& lhs, const std::string& rhs) {
+                return lhs.compare(std::min(depth, lhs.size()), std::string::npos,
+                                   rhs, std::min(depth, rhs.size()), std::string::npos) < 0;
+            });
+            continue;
+        }
+
+        offsets.fill(0);
+        for (It it = bucket.begin; it != bucket.end; ++it) {
+            ++offsets[StringDigit(*it, depth) + 1];
+        }
+        for (size_t digit = 0; digit < kStringRadix; ++digit) {
+            offsets[digit + 1] += offsets[digit];
+        }
+
+        bounds = offsets;
+        for (It it = bucket.begin; it != bucket.end; ++it) {
+            tmp[offsets[StringDigit(*it, depth)]++] = std::move(*it);
+        }
+        std::move(tmp.begin(), tmp.begin() + size, bucket.begin);
+
+        // Bucket 0 holds strings that are already exhausted and therefore equal
+        for (size_t digit = 1; digit < kStringRadix; ++digit) {
+            if (bounds[digit + 1] - bounds[digit] > 1) {
+                buckets.push_back({bucket.begin + bounds[digit], bucket.begin + bounds[digit + 1], depth + 1});
+            }
+        }
+    }
+}
+
+int main() {
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    size_t number;
+    std::cin >> number;
+    std::vector<Person> people(number);
+    for (size_t i = 0; i < number; ++i) {
+        std::cin >> people[i].surname_ >> people[i].name_ >> people[i].points_;
+    }
+
+    // Descending order by points, stable for equal points; ~x reverses the order without overflowing at INT_MIN
+    LsdRadixSort(people.begin(), people.end(), [](const Person& person) { return ~person.points_; },
+                 std::max(1u, std::thread::hardware_concurrency()));
+    for (const auto& person : people) {
+        std::cout << person.surname_ << ' ' << person.name_ << '\n';
+    }
+
+    size_t words_number;
+    std::cin >> words_number;
+    std::vector<std::string> words(words_number);
+    for (size_t i = 0; i < words_number; ++i) {
+        std::cin >> words[i];
+    }
+
+    MsdRadixSort(words.begin(), words.end());
+    for (const auto& word : words) {
+        std::cout << word << '\n';
+    }
+
+    return 0;
+}
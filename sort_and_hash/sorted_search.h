@@ -0,0 +1,130 @@
+#ifndef SORT_AND_HASH_SORTED_SEARCH_H
+#define SORT_AND_HASH_SORTED_SEARCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// lower_bound without data-dependent branches: the loop length depends on size only,
+// and the comparison result becomes a conditional move
+template <class T>
+size_t BranchlessLowerBound(const T* data, size_t size, const T& value) {
+    if (size == 0) {
+        return 0;
+    }
+    const T* base = data;
+    while (size > 1) {
+        const size_t half = size / 2;
+        base = (base[half - 1] < value) ? base + half : base;
+        size -= half;
+    }
+    return (base - data) + (*base < value);
+}
+
+const size_t kInterleavedQueries = 16;
+
+// Runs a group of branchless searches in lockstep, so their cache misses overlap
+template <class T>
+void LowerBoundMany(const T* data, size_t size, const T* queries, size_t count, size_t* out) {
+    for (size_t group = 0; group < count; group += kInterleavedQueries) {
+        const size_t group_size = std::min(kInterleavedQueries, count - group);
+        if (size == 0) {
+            std::fill(out + group, out + group + group_size, 0);
+            continue;
+        }
+
+        const T* bases[kInterleavedQueries];
+        std::fill(bases, bases + group_size, data);
+        size_t length = size;
+        while (length > 1) {
+            const size_t half = length / 2;
+            for (size_t i = 0; i < group_size; ++i) {
+                bases[i] = (bases[i][half - 1] < queries[group + i]) ? bases[i] + half : bases[i];
+            }
+            length -= half;
+            const size_t next_half = length / 2;
+            for (size_t i = 0; i < group_size && next_half > 0; ++i) {
+                __builtin_prefetch(bases[i] + next_half - 1);
+                __builtin_prefetch(bases[i] + length - 1);
+            }
+        }
+        for (size_t i = 0; i < group_size; ++i) {
+            out[group + i] = (bases[i] - data) + (*bases[i] < queries[group + i]);
+        }
+    }
+}
+
+// Sorted values in BFS order of an implicit binary search tree: node k has children 2k and 2k + 1.
+// The first levels share cache lines, and the 16 descendants four levels below one node
+// are contiguous, so they are prefetched in one go.
+template <class T>
+class EytzingerArray {
+public:
+    explicit EytzingerArray(const std::vector<T>& sorted)
+        : tree_(sorted.size() + 1), positions_(sorted.size() + 1, sorted.size()) {
+        size_t next = 0;
+        Fill(sorted, 1, next);
+    }
+
+    size_t Size() const {
+        return tree_.size() - 1;
+    }
+
+    // Index of the first element not less than value in the original sorted order
+    size_t LowerBound(const T& value) const {
+        const size_t size = Size();
+        size_t node = 1;
+        while (node <= size) {
+            __builtin_prefetch(tree_.data() + std::min(node * kPrefetchFanout, size));
+            node = 2 * node + (tree_[node] < value);
+        }
+        // Undo the right turns after the last left turn
+        node >>= __builtin_ffsll(~node);
+        return positions_[node];
+    }
+
+    void LowerBoundMany(const T* queries, size_t count, size_t* out) const {
+        const size_t size = Size();
+        size_t nodes[kInterleavedQueries];
+        for (size_t group = 0; group < count; group += kInterleavedQueries) {
+            const size_t group_size = std::min(kInterleavedQueries, count - group);
+            std::fill(nodes, nodes + group_size, 1);
+
+            // All nodes of a group are on the same level, so they leave the tree together
+            while (nodes[0] <= size) {
+                for (size_t i = 0; i < group_size; ++i) {
+                    if (nodes[i] <= size) {
+                        __builtin_prefetch(tree_.data() + std::min(nodes[i] * kPrefetchFanout, size));
+                        nodes[i] = 2 * nodes[i] + (tree_[nodes[i]] < queries[group + i]);
+                    }
+                }
+            }
+            for (size_t i = 0; i < group_size; ++i) {
+                size_t node = nodes[i];
+                while (node <= size) {
+                    node = 2 * node + (tree_[node] < queries[group + i]);
+                }
+                out[group + i] = positions_[node >> __builtin_ffsll(~node)];
+            }
+        }
+    }
+
+private:
+    static const size_t kPrefetchFanout = 16;
+
+    void Fill(const std::vector<T>& sorted, size_t node, size_t& next) {
+        if (node >= tree_.size()) {
+            return;
+        }
+        Fill(sorted, 2 * node, next);
+        positions_[node] = next;
+        tree_[node] = sorted[next++];
+        Fill(sorted, 2 * node + 1, next);
+    }
+
+    std::vector<T> tree_;
+    // positions_[0] stays equal to the size, it is the answer for values above the maximum
+    std::vector<size_t> positions_;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "sorted_search.h"
+
+template <class Function>
+double MeasureNanosecondsPerQuery(size_t queries_number, Function function) {
+    return MeasureSeconds(function) * 1e9 / queries_number;
+}
+
+int main() {
+    const size_t kQueriesNumber = 1 << 20;
+    // Roughly L1, L2, L3 and DRAM sized arrays of int
+    const size_t kSizes[] = {(1 << 14) / sizeof(int), (1 << 18) / sizeof(int), (1 << 23) / sizeof(int),
+                             (1 << 27) / sizeof(int)};
+
+    std::mt19937 generator;
+    std::cout << "elements\tstd_ns\tbranchless_ns\tbatched_ns\teytzinger_ns\teytzinger_batched_ns\n";
+    for (size_t size : kSizes) {
+        std::uniform_int_distribution<int> distr(0, static_cast<int>(2 * size));
+        std::vector<int> data(size);
+        for (auto& elem : data) {
+            elem = distr(generator);
+        }
+        std::sort(data.begin(), data.end());
+        EytzingerArray<int> eytzinger(data);
+
+        std::vector<int> queries(kQueriesNumber);
+        for (auto& query : queries) {
+            query = distr(generator);
+        }
+
+        std::vector<size_t> expected(kQueriesNumber), results(kQueriesNumber);
+        double std_time = MeasureNanosecondsPerQuery(kQueriesNumber, [&]() {
+            for (size_t i = 0; i < kQueriesNumber; ++i) {
+                expected[i] = std::lower_bound(data.begin(), data.end(), queries[i]) - data.begin();
+            }
+        });
+
+        bool correct = true;
+        auto check = [&]() {
+            correct = correct && results == expected;
+        };
+        double branchless_time = MeasureNanosecondsPerQuery(kQueriesNumber, [&]() {
+            for (size_t i = 0; i < kQueriesNumber; ++i) {
+                results[i] = BranchlessLowerBound(data.data(), data.size(), queries[i]);
+            }
+        });
+        check();
+        double batched_time = MeasureNanosecondsPerQuery(kQueriesNumber, [&]() {
+            LowerBoundMany(data.data(), data.size(), queries.data(), kQueriesNumber, results.data());
+        });
+        check();
+        double eytzinger_time = MeasureNanosecondsPerQuery(kQueriesNumber, [&]() {
+            for (size_t i = 0; i < kQueriesNumber; ++i) {
+                results[i] = eytzinger.LowerBound(queries[i]);
+            }
+        });
+        check();
+        double eytzinger_batched_time = MeasureNanosecondsPerQuery(kQueriesNumber, [&]() {
+            eytzinger.LowerBoundMany(queries.data(), kQueriesNumber, results.data());
+        });
+        check();
+
+        if (!correct) {
+            std::cerr << "Results differ from std::lower_bound for " << size << " elements\n";
+            return 1;
+        }
+        std::cout << size << '\t' << std_time << '\t' << branchless_time << '\t' << batched_time << '\t'
+                  << eytzinger_time << '\t' << eytzinger_batched_time << '\n';
+    }
+
+    return 0;
+}
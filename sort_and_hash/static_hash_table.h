@@ -0,0 +1,676 @@
+#ifndef SORT_AND_HASH_STATIC_HASH_TABLE_H
+#define SORT_AND_HASH_STATIC_HASH_TABLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "multiply_shift_hash_function.h"
+
+template <class Hash>
+struct StaticHashBucket {
+    Hash hash;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+// Image layout: header, primary hash, buckets, cells, key bytes; every section is 8-byte aligned.
+// The tags identify the key and hash types, so an image is only mapped by the table type that saved it
+struct StaticHashImageHeader {
+    uint64_t magic;
+    uint64_t key_tag;
+    uint64_t hash_tag;
+    uint64_t buckets_number;
+    uint64_t cells_number;
+    uint64_t blob_size;
+    uint64_t hash_size;
+};
+
+struct StaticHashImageCell {
+    uint64_t offset = 0;
+    uint64_t length = kEmptyCell;
+
+    static const uint64_t kEmptyCell = static_cast<uint64_t>(-1);
+};
+
+const uint64_t kStaticHashImageMagic = 0x32474d4948415453ULL;  // "STAHIMG2"
+const size_t kStaticHashImageAlignment = 8;
+
+inline size_t AlignImageSection(size_t size) {
+    return (size + kStaticHashImageAlignment - 1) / kStaticHashImageAlignment * kStaticHashImageAlignment;
+}
+
+inline void WriteImageSection(std::ofstream& out, const void* data, size_t size) {
+    static const char kPadding[kStaticHashImageAlignment] = {};
+    out.write(static_cast<const char*>(data), size);
+    out.write(kPadding, AlignImageSection(size) - size);
+}
+
+// FNV-1a of the mangled type name. Images hold raw structs and are only portable between builds
+// of one compiler anyway, and within one ABI the mangled name is stable and unique per type.
+template <class T>
+uint64_t ImageTypeTag() {
+    uint64_t tag = 0xcbf29ce484222325ULL;
+    for (const char* symb = typeid(T).name(); *symb != '\0'; ++symb) {
+        tag = (tag ^ static_cast<unsigned char>(*symb)) * 0x100000001b3ULL;
+    }
+    return tag;
+}
+
+// Keys are stored in images as raw bytes
+inline std::string_view KeyBytes(const std::string& key) {
+    return key;
+}
+
+template <class T>
+std::string_view KeyBytes(const T& key) {
+    static_assert(std::is_trivially_copyable<T>::value, "Key must be a string or trivially copyable");
+    return std::string_view(reinterpret_cast<const char*>(&key), sizeof(T));
+}
+
+const size_t kParallelChunkSize = 1 << 12;
+
+// Threads of one build. They are started once and run every phase passed to Run,
+// so a build made of several parallel phases does not start threads for each of them
+class WorkerTeam {
+public:
+    explicit WorkerTeam(size_t threads_number) : threads_number_(std::max<size_t>(threads_number, 1)) {
+        for (size_t thread_no = 1; thread_no < threads_number_; ++thread_no) {
+            threads_.emplace_back([this, thread_no]() { Work(thread_no); });
+        }
+    }
+
+    WorkerTeam(const WorkerTeam&) = delete;
+    WorkerTeam& operator=(const WorkerTeam&) = delete;
+
+    ~WorkerTeam() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+            ++generation_;
+        }
+        started_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    size_t Size() const {
+        return threads_number_;
+    }
+
+    // Calls function(thread_no) for every thread_no in [0, Size()) on its own thread and waits for all of them
+    template <class Function>
+    void Run(Function function) {
+        if (threads_.empty()) {
+            function(0);
+            return;
+        }
+        const std::function<void(size_t)> task = function;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            running_ = threads_.size();
+            ++generation_;
+        }
+        started_.notify_all();
+
+        // The workers use task until they are done, so an exception waits for them too
+        std::exception_ptr error;
+        try {
+            task(0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [&]() { return running_ == 0; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Calls function(i) for every i in [0, count). Threads take indices from a shared counter in chunks,
+    // so uneven per-index costs stay balanced
+    template <class Function>
+    void ParallelFor(size_t count, Function function) {
+        if (threads_.empty() || count <= kParallelChunkSize) {
+            for (size_t i = 0; i < count; ++i) {
+                function(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next_chunk(0);
+        Run([&](size_t) {
+            while (true) {
+                const size_t chunk_begin = next_chunk.fetch_add(kParallelChunkSize);
+                if (chunk_begin >= count) {
+                    return;
+                }
+                const size_t chunk_end = std::min(count, chunk_begin + kParallelChunkSize);
+                for (size_t i = chunk_begin; i < chunk_end; ++i) {
+                    function(i);
+                }
+            }
+        });
+    }
+
+private:
+    void Work(size_t thread_no) {
+        uint64_t seen_generation = 0;
+        while (true) {
+            const std::function<void(size_t)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                started_.wait(lock, [&]() { return generation_ != seen_generation; });
+                seen_generation = generation_;
+                if (stopped_) {
+                    return;
+                }
+                task = task_;
+            }
+            (*task)(thread_no);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--running_ == 0) {
+                finished_.notify_one();
+            }
+        }
+    }
+
+    size_t threads_number_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable started_;
+    std::condition_variable finished_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t running_ = 0;
+    uint64_t generation_ = 0;
+    bool stopped_ = false;
+};
+
+// Hash needs operator()(key), HashMany(keys, count, out) over an iterator and a static MakeHash(generator)
+template <class T, class Hash, class Equal = std::equal_to<T>>
+class StaticHashTable {
+public:
+    // Iterators must be random access, the build is split between threads_number threads.
+    // Elements reach their buckets through two counting scatters without shared counters: every thread
+    // counts its elements per part into its own histogram, a scan over the histograms gives every thread
+    // its own write offsets inside every part, and then every part is put in bucket order by its owner alone
+    template<class Iterator>
+    StaticHashTable(Iterator begin, Iterator end, size_t threads_number = std::thread::hardware_concurrency())
+        : buckets_(std::distance(begin, end)) {
+        std::mt19937 generator;
+        const size_t size = buckets_.size();
+        WorkerTeam team(threads_number);
+        const Partition partition{size, team.Size()};
+
+        std::vector<size_t> bucket_ids(size);
+        std::vector<size_t> order(size);
+        std::vector<size_t> part_begins(partition.parts + 1);
+        std::vector<size_t> bucket_sizes(size);
+        primary_hash_ = BuildPrimaryHash(begin, generator, team, partition, bucket_ids, order, part_begins, bucket_sizes);
+
+        // All buckets share one contiguous array of cells, offsets are scanned inside the parts
+        // and then over the part totals
+        std::vector<size_t> bucket_begins(size + 1, size);
+        std::vector<size_t> part_cells(partition.parts + 1);
+        team.Run([&](size_t part) {
+            size_t elements_offset = part_begins[part];
+            size_t cells_offset = 0;
+            for (size_t i = partition.BucketsBegin(part); i < partition.BucketsBegin(part + 1); ++i) {
+                bucket_begins[i] = elements_offset;
+                elements_offset += bucket_sizes[i];
+                buckets_[i].offset = cells_offset;
+                buckets_[i].size = bucket_sizes[i] * bucket_sizes[i];
+                cells_offset += buckets_[i].size;
+            }
+            part_cells[part + 1] = cells_offset;
+        });
+        for (size_t part = 0; part < partition.parts; ++part) {
+            part_cells[part + 1] += part_cells[part];
+        }
+        cells_.resize(part_cells.back());
+
+        // Every part moves its elements into bucket order, bucket_sizes become its write cursors
+        std::vector<T> elements(size);
+        team.Run([&](size_t part) {
+            for (size_t i = partition.BucketsBegin(part); i < partition.BucketsBegin(part + 1); ++i) {
+                buckets_[i].offset += part_cells[part];
+                bucket_sizes[i] = bucket_begins[i];
+            }
+            for (size_t k = part_begins[part]; k < part_begins[part + 1]; ++k) {
+                elements[bucket_sizes[bucket_ids[order[k]]]++] = begin[order[k]];
+            }
+        });
+
+        // Secondary tables are independent; each bucket seeds its own generator,
+        // so the result does not depend on scheduling
+        team.ParallelFor(size, [&](size_t i) {
+            Bucket& bucket = buckets_[i];
+            if (bucket.size == 0) {
+                return;
+            }
+            auto bucket_begin = elements.begin() + bucket_begins[i];
+            auto bucket_end = elements.begin() + bucket_begins[i + 1];
+            std::minstd_rand bucket_generator(i + 1);
+            bucket.hash = BuildSecondaryHash(bucket_begin, bucket_end, bucket_generator);
+
+            for (auto it = bucket_begin; it != bucket_end; ++it) {
+                const size_t hash_id = bucket.hash(*it) % bucket.size;
+                cells_[bucket.offset + hash_id] = std::move(*it);
+            }
+        });
+    }
+
+    bool Find(const T& key) const {
+        if (buckets_.empty()) {
+            return false;
+        }
+        const Bucket& bucket = buckets_[primary_hash_(key) % buckets_.size()];
+        if (bucket.size == 0) {
+            return false;
+        }
+        const std::optional<T>& cell = cells_[bucket.offset + bucket.hash(key) % bucket.size];
+        return cell.has_value() && equal_(key, *cell);
+    }
+
+    // Looks keys up in groups: all primary hashes of a group are computed by one HashMany call,
+    // then bucket headers and cells are prefetched, so the random accesses of different keys overlap
+    template <class Iterator, class OutputIterator>
+    OutputIterator FindBatch(Iterator begin, Iterator end, OutputIterator found) const {
+        size_t bucket_ids[kBatchSize];
+        size_t cell_ids[kBatchSize];
+
+        while (begin != end) {
+            Iterator group_end = begin;
+            size_t group_size = 0;
+            while (group_end != end && group_size < kBatchSize) {
+                ++group_end;
+                ++group_size;
+            }
+            if (buckets_.empty()) {
+                found = std::fill_n(found, group_size, false);
+                begin = group_end;
+                continue;
+            }
+
+            primary_hash_.HashMany(begin, group_size, bucket_ids);
+            for (size_t i = 0; i < group_size; ++i) {
+                bucket_ids[i] %= buckets_.size();
+                __builtin_prefetch(&buckets_[bucket_ids[i]]);
+            }
+
+            Iterator it = begin;
+            for (size_t i = 0; i < group_size; ++i, ++it) {
+                const Bucket& bucket = buckets_[bucket_ids[i]];
+                cell_ids[i] = bucket.size == 0 ? kNoCell : bucket.offset + bucket.hash(*it) % bucket.size;
+                if (cell_ids[i] != kNoCell) {
+                    __builtin_prefetch(&cells_[cell_ids[i]]);
+                }
+            }
+
+            it = begin;
+            for (size_t i = 0; i < group_size; ++i, ++it) {
+                *found = cell_ids[i] != kNoCell && cells_[cell_ids[i]].has_value() && equal_(*it, *cells_[cell_ids[i]]);
+                ++found;
+            }
+            begin = group_end;
+        }
+        return found;
+    }
+
+    // Writes an image that MappedStaticHashTable serves without deserialization
+    void Save(const std::string& path) const {
+        static_assert(std::is_trivially_copyable<Hash>::value, "Hash parameters are stored as raw bytes");
+
+        std::vector<StaticHashImageCell> cells(cells_.size());
+        std::string blob;
+        for (size_t i = 0; i < cells_.size(); ++i) {
+            if (cells_[i].has_value()) {
+                std::string_view bytes = KeyBytes(*cells_[i]);
+                cells[i] = {blob.size(), bytes.size()};
+                blob.append(bytes);
+            }
+        }
+
+        StaticHashImageHeader header = {kStaticHashImageMagic, ImageTypeTag<T>(), ImageTypeTag<Hash>(),
+                                        buckets_.size(), cells.size(), blob.size(), sizeof(Hash)};
+        std::ofstream out(path, std::ios::binary);
+        WriteImageSection(out, &header, sizeof(header));
+        WriteImageSection(out, &primary_hash_, sizeof(Hash));
+        WriteImageSection(out, buckets_.data(), buckets_.size() * sizeof(Bucket));
+        WriteImageSection(out, cells.data(), cells.size() * sizeof(StaticHashImageCell));
+        WriteImageSection(out, blob.data(), blob.size());
+        if (!out) {
+            throw std::runtime_error("Can not write image " + path);
+        }
+    }
+
+private:
+    // There are as many buckets as elements. Thread t hashes elements [ElementsBegin(t), ElementsBegin(t + 1))
+    // and owns the buckets of part t, [BucketsBegin(t), BucketsBegin(t + 1))
+    struct Partition {
+        size_t size;
+        size_t parts;
+
+        size_t ElementsBegin(size_t thread_no) const {
+            return size * thread_no / parts;
+        }
+
+        size_t BucketsBegin(size_t part) const {
+            return (size * part + parts - 1) / parts;
+        }
+
+        size_t PartOf(size_t bucket) const {
+            return bucket * parts / size;
+        }
+    };
+
+    // Fills bucket_ids with the primary bucket of every element, order with element indices grouped
+    // by part (part p is [part_begins[p], part_begins[p + 1])) and bucket_sizes
+    template <class Iterator>
+    static Hash BuildPrimaryHash(Iterator begin, std::mt19937& generator, WorkerTeam& team, const Partition& partition,
+                                 std::vector<size_t>& bucket_ids, std::vector<size_t>& order,
+                                 std::vector<size_t>& part_begins, std::vector<size_t>& bucket_sizes) {
+        const size_t size = partition.size;
+        const size_t parts = partition.parts;
+        // Row t holds the histogram of thread t over parts, then its write cursors
+        std::vector<size_t> cursors(parts * parts);
+        std::vector<size_t> part_squares(parts);
+        Hash primary_hash = Hash::MakeHash(generator);
+
+        while (true) {
+            team.Run([&](size_t thread_no) {
+                std::vector<size_t> histogram(parts);
+                const size_t elements_begin = partition.ElementsBegin(thread_no);
+                const size_t elements_end = partition.ElementsBegin(thread_no + 1);
+                primary_hash.HashMany(begin + elements_begin, elements_end - elements_begin,
+                                      bucket_ids.data() + elements_begin);
+                for (size_t i = elements_begin; i < elements_end; ++i) {
+                    bucket_ids[i] %= size;
+                    ++histogram[partition.PartOf(bucket_ids[i])];
+                }
+                std::copy(histogram.begin(), histogram.end(), cursors.begin() + thread_no * parts);
+            });
+            size_t offset = 0;
+            for (size_t part = 0; part < parts; ++part) {
+                part_begins[part] = offset;
+                for (size_t thread_no = 0; thread_no < parts; ++thread_no) {
+                    const size_t count = cursors[thread_no * parts + part];
+                    cursors[thread_no * parts + part] = offset;
+                    offset += count;
+                }
+            }
+            part_begins[parts] = offset;
+
+            team.Run([&](size_t thread_no) {
+                std::vector<size_t> own_cursors(cursors.begin() + thread_no * parts,
+                                                cursors.begin() + (thread_no + 1) * parts);
+                for (size_t i = partition.ElementsBegin(thread_no); i < partition.ElementsBegin(thread_no + 1); ++i) {
+                    order[own_cursors[partition.PartOf(bucket_ids[i])]++] = i;
+                }
+            });
+            team.Run([&](size_t part) {
+                const size_t buckets_begin = partition.BucketsBegin(part);
+                const size_t buckets_end = partition.BucketsBegin(part + 1);
+                std::fill(bucket_sizes.begin() + buckets_begin, bucket_sizes.begin() + buckets_end, 0);
+                for (size_t k = part_begins[part]; k < part_begins[part + 1]; ++k) {
+                    ++bucket_sizes[bucket_ids[order[k]]];
+                }
+                size_t squares = 0;
+                for (size_t i = buckets_begin; i < buckets_end; ++i) {
+                    squares += bucket_sizes[i] * bucket_sizes[i];
+                }
+                part_squares[part] = squares;
+            });
+
+            size_t sum_squares = 0;
+            for (size_t squares : part_squares) {
+                sum_squares += squares;
+            }
+            if (sum_squares <= kMaxScale * size) {
+                break;
+            }
+            primary_hash = Hash::MakeHash(generator);
+        }
+        return primary_hash;
+    }
+
+    template <class Iterator, class Generator>
+    static Hash BuildSecondaryHash(Iterator begin, Iterator end, Generator& generator) {
+        const size_t elements_count = std::distance(begin, end);
+        const size_t bucket_size = elements_count * elements_count;
+        std::vector<bool> cell_full(bucket_size, false);
+        Hash hash = Hash::MakeHash(generator);
+
+        while (true) {
+            std::fill(cell_full.begin(), cell_full.end(), false);
+
+            bool has_collisions = false;
+            for (auto it = begin; it != end && !has_collisions; ++it) {
+                size_t index = hash(*it) % bucket_size;
+                if (cell_full[index]) {
+                    has_collisions = true;
+                }
+                cell_full[index] = true;
+            }
+
+            if (!has_collisions) {
+                break;
+            }
+            hash = Hash::MakeHash(generator);
+        }
+
+        return hash;
+    }
+
+private:
+    using Bucket = StaticHashBucket<Hash>;
+
+    static const size_t kMaxScale = 4;
+    static const size_t kBatchSize = 16;
+    static const size_t kNoCell = static_cast<size_t>(-1);
+
+    std::vector<Bucket> buckets_;
+    std::vector<std::optional<T>> cells_;
+    Hash primary_hash_;
+    Equal equal_;
+};
+
+// Read-only table over a mapped image written by StaticHashTable::Save. Loading costs one mmap call
+// and one pass over the buckets and cells that checks the image is consistent
+template <class T, class Hash, class Equal = std::equal_to<std::string_view>>
+class MappedStaticHashTable {
+public:
+    explicit MappedStaticHashTable(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Can not open image " + path);
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(StaticHashImageHeader)) {
+            close(fd);
+            throw std::runtime_error("Bad image " + path);
+        }
+        mapped_size_ = file_stat.st_size;
+        void* data = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Can not map image " + path);
+        }
+        data_ = static_cast<const char*>(data);
+
+        const auto* header = reinterpret_cast<const StaticHashImageHeader*>(data_);
+        if (header->magic != kStaticHashImageMagic || header->key_tag != ImageTypeTag<T>() ||
+            header->hash_tag != ImageTypeTag<Hash>() || header->hash_size != sizeof(Hash)) {
+            munmap(const_cast<char*>(data_), mapped_size_);
+            throw std::runtime_error("Image " + path + " was built for another table type");
+        }
+        if (!MapSections(*header)) {
+            munmap(const_cast<char*>(data_), mapped_size_);
+            throw std::runtime_error("Image " + path + " is truncated or corrupted");
+        }
+    }
+
+    MappedStaticHashTable(const MappedStaticHashTable&) = delete;
+    MappedStaticHashTable& operator=(const MappedStaticHashTable&) = delete;
+
+    ~MappedStaticHashTable() {
+        munmap(const_cast<char*>(data_), mapped_size_);
+    }
+
+    bool Find(const T& key) const {
+        if (buckets_number_ == 0) {
+            return false;
+        }
+        const StaticHashBucket<Hash>& bucket = buckets_[(*primary_hash_)(key) % buckets_number_];
+        if (bucket.size == 0) {
+            return false;
+        }
+        const StaticHashImageCell& cell = cells_[bucket.offset + bucket.hash(key) % bucket.size];
+        return cell.length != StaticHashImageCell::kEmptyCell &&
+               equal_(KeyBytes(key), std::string_view(blob_ + cell.offset, cell.length));
+    }
+
+private:
+    // Points the sections into the mapping. Every section must lie inside it, and every bucket and
+    // cell must point inside its own section, so a damaged image can not make Find read out of bounds.
+    bool MapSections(const StaticHashImageHeader& header) {
+        size_t position = AlignImageSection(sizeof(StaticHashImageHeader));
+        auto take_section = [&](uint64_t count, size_t element_size) -> const char* {
+            const size_t left = position <= mapped_size_ ? mapped_size_ - position : 0;
+            if (count > left / element_size) {
+                return nullptr;
+            }
+            const char* section = data_ + position;
+            position += AlignImageSection(count * element_size);
+            return section;
+        };
+
+        primary_hash_ = reinterpret_cast<const Hash*>(take_section(1, sizeof(Hash)));
+        buckets_ = reinterpret_cast<const StaticHashBucket<Hash>*>(
+            take_section(header.buckets_number, sizeof(StaticHashBucket<Hash>)));
+        cells_ = reinterpret_cast<const StaticHashImageCell*>(
+            take_section(header.cells_number, sizeof(StaticHashImageCell)));
+        blob_ = take_section(header.blob_size, 1);
+        if (primary_hash_ == nullptr || buckets_ == nullptr || cells_ == nullptr || blob_ == nullptr) {
+            return false;
+        }
+        buckets_number_ = header.buckets_number;
+
+        for (size_t i = 0; i < buckets_number_; ++i) {
+            if (buckets_[i].offset > header.cells_number || buckets_[i].size > header.cells_number - buckets_[i].offset) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < header.cells_number; ++i) {
+            const StaticHashImageCell& cell = cells_[i];
+            if (cell.length != StaticHashImageCell::kEmptyCell &&
+                (cell.offset > header.blob_size || cell.length > header.blob_size - cell.offset)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const char* data_ = nullptr;
+    size_t mapped_size_ = 0;
+    const Hash* primary_hash_ = nullptr;
+    const StaticHashBucket<Hash>* buckets_ = nullptr;
+    size_t buckets_number_ = 0;
+    const StaticHashImageCell* cells_ = nullptr;
+    const char* blob_ = nullptr;
+    Equal equal_;
+};
+
+template <class T>
+class HashFunction {
+public:
+    HashFunction() = default;
+
+    HashFunction(size_t initial_value, size_t multiplier) : initial_value_(initial_value), multiplier_(multiplier) {
+    }
+
+    size_t operator()(const T& value) const {
+        return (initial_value_ + value * multiplier_) % kPrimeNumber;
+    }
+
+    // Hashes count keys starting at keys into out. StaticHashTable hashes whole ranges through it:
+    // the prime is a compile-time constant, so the modulo is a multiply by its inverse,
+    // and the loop keeps the parameters in registers and has no call per key
+    template <class Iterator>
+    void HashMany(Iterator keys, size_t count, size_t* out) const {
+        const size_t initial_value = initial_value_;
+        const size_t multiplier = multiplier_;
+        for (size_t i = 0; i < count; ++i, ++keys) {
+            out[i] = (initial_value + *keys * multiplier) % kPrimeNumber;
+        }
+    }
+
+    template <class Generator>
+    static HashFunction MakeHash(Generator& generator) {
+        std::uniform_int_distribution<size_t> distr(1, kPrimeNumber - 1);
+        return HashFunction(distr(generator), distr(generator));
+    }
+
+private:
+    static const size_t kPrimeNumber = 2000000011;
+    size_t initial_value_ = 1;
+    size_t multiplier_ = 1;
+};
+
+template <>
+class HashFunction<std::string> {
+public:
+    HashFunction() = default;
+
+    HashFunction(size_t initial_value, size_t multiplier) : initial_value_(initial_value), multiplier_(multiplier) {
+    }
+
+    size_t operator()(const std::string& value) const {
+        size_t hash = initial_value_;
+
+        for (auto symb : value) {
+            hash = (hash * multiplier_ + symb) % kPrimeNumber;
+        }
+        return hash;
+    }
+
+    template <class Iterator>
+    void HashMany(Iterator keys, size_t count, size_t* out) const {
+        for (size_t i = 0; i < count; ++i, ++keys) {
+            out[i] = (*this)(*keys);
+        }
+    }
+
+    template <class Generator>
+    static HashFunction MakeHash(Generator& generator) {
+        std::uniform_int_distribution<size_t> distr(1, kPrimeNumber - 1);
+        return HashFunction(distr(generator), distr(generator));
+    }
+
+private:
+    static const size_t kPrimeNumber = 2000000011;
+    size_t initial_value_ = 1;
+    size_t multiplier_ = 1;
+};
+
+#endif
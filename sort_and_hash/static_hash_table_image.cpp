@@ -0,0 +1,49 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "static_hash_table.h"
+
+// build <image>: reads a dictionary from stdin and writes its table image
+// query <image>: maps the image and answers the queries from stdin
+int main() {
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    std::string mode, image_path;
+    std::cin >> mode >> image_path;
+
+    if (mode == "build") {
+        size_t strings_number;
+        std::cin >> strings_number;
+        std::vector<std::string> strings(strings_number);
+        for (size_t i = 0; i < strings_number; ++i) {
+            std::cin >> strings[i];
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        StaticHashTable<std::string, HashFunction<std::string>> set(strings.begin(), strings.end());
+        set.Save(image_path);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cerr << "Built image of " << strings_number << " keys in " << elapsed.count() << " s\n";
+    } else if (mode == "query") {
+        MappedStaticHashTable<std::string, HashFunction<std::string>> set(image_path);
+
+        size_t queries_number;
+        std::cin >> queries_number;
+        std::string query;
+        for (size_t i = 0; i < queries_number; ++i) {
+            std::cin >> query;
+            if (set.Find(query)) {
+                std::cout << "YES\n";
+            } else {
+                std::cout << "NO\n";
+            }
+        }
+    } else {
+        std::cerr << "Unknown mode " << mode << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+#ifndef SORT_AND_HASH_STRING_HASH_H
+#define SORT_AND_HASH_STRING_HASH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+class StringHash {
+public:
+    StringHash() = default;
+
+    StringHash(size_t seed) : seed_(seed) {
+    }
+
+    size_t operator()(const std::string& value) const {
+        size_t hash = seed_ ^ (value.length() * kMultiplier);
+
+        const uint64_t* data = static_cast<const uint64_t*>(static_cast<const void*>(value.data()));
+        const uint64_t* end = data + value.length() / sizeof(uint64_t);
+
+        while (data != end) {
+            uint64_t elem = *data;
+            ++data;
+
+            elem *= kMultiplier;
+            elem ^= elem >> kBitOffset;
+            elem *= kMultiplier;
+
+            hash ^= elem;
+            hash *= kMultiplier;
+        }
+
+        const uint8_t* remainder = static_cast<const uint8_t*>(static_cast<const void*>(data));
+        size_t remainder_len = value.length() % 8;
+        for (size_t i = 0; i < remainder_len; ++i) {
+            hash ^= static_cast<uint64_t>(remainder[i]) << (i * 8);
+        }
+
+        hash *= kMultiplier;
+        hash ^= hash >> kBitOffset;
+        hash *= kMultiplier;
+        hash ^= hash >> kBitOffset;
+
+        return hash;
+    }
+
+private:
+    static const size_t kMultiplier = 0xc6a4a7935bd1e995ULL;
+    static const size_t kBitOffset = 47;
+
+    size_t seed_ = 0;
+};
+
+// Streaming variant of the same mixing: four independent 64-bit lanes eat 32 bytes per step,
+// so the lanes map onto one AVX2 register (compile with -mavx2) or pipeline well as scalars.
+// Update may be called with any split of the input, Finalize gives the same value for all splits.
+class WideStringHasher {
+public:
+    static const size_t kBlockSize = 32;
+
+    explicit WideStringHasher(size_t seed = 0) : seed_(seed) {
+        for (size_t i = 0; i < kLanes; ++i) {
+            lanes_[i] = seed ^ kLaneSeeds[i];
+        }
+    }
+
+    void Update(const void* data, size_t length) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        total_length_ += length;
+
+        if (buffered_ > 0) {
+            const size_t taken = std::min(length, kBlockSize - buffered_);
+            std::memcpy(buffer_ + buffered_, bytes, taken);
+            buffered_ += taken;
+            bytes += taken;
+            length -= taken;
+            if (buffered_ < kBlockSize) {
+                return;
+            }
+            ProcessBlocks(buffer_, 1);
+            buffered_ = 0;
+        }
+
+        const size_t blocks = length / kBlockSize;
+        ProcessBlocks(bytes, blocks);
+        bytes += blocks * kBlockSize;
+        length -= blocks * kBlockSize;
+
+        std::memcpy(buffer_, bytes, length);
+        buffered_ = length;
+    }
+
+    size_t Finalize() const {
+        uint64_t hash = seed_ ^ (total_length_ * kMultiplier);
+        for (size_t i = 0; i < kLanes; ++i) {
+            hash ^= Mix(lanes_[i]);
+            hash *= kMultiplier;
+        }
+
+        size_t position = 0;
+        for (; position + sizeof(uint64_t) <= buffered_; position += sizeof(uint64_t)) {
+            uint64_t elem;
+            std::memcpy(&elem, buffer_ + position, sizeof(elem));
+            hash ^= Mix(elem);
+            hash *= kMultiplier;
+        }
+        for (size_t i = 0; position + i < buffered_; ++i) {
+            hash ^= static_cast<uint64_t>(buffer_[position + i]) << (i * 8);
+        }
+
+        hash *= kMultiplier;
+        hash ^= hash >> kBitOffset;
+        hash *= kMultiplier;
+        hash ^= hash >> kBitOffset;
+
+        return hash;
+    }
+
+private:
+    static const size_t kLanes = kBlockSize / sizeof(uint64_t);
+    static const uint64_t kMultiplier = 0xc6a4a7935bd1e995ULL;
+    static const size_t kBitOffset = 47;
+    static constexpr uint64_t kLaneSeeds[kLanes] = {
+        0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL, 0x2545f4914f6cdd1dULL};
+
+    static uint64_t Mix(uint64_t elem) {
+        elem *= kMultiplier;
+        elem ^= elem >> kBitOffset;
+        elem *= kMultiplier;
+        return elem;
+    }
+
+#ifdef __AVX2__
+    // AVX2 has no 64-bit low multiply, it is assembled from three 32x32 products
+    static __m256i MultiplyLow64(__m256i value, __m256i multiplier) {
+        const __m256i low = _mm256_mul_epu32(value, multiplier);
+        const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(value, 32), multiplier),
+                                               _mm256_mul_epu32(value, _mm256_srli_epi64(multiplier, 32)));
+        return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+    }
+
+    void ProcessBlocks(const uint8_t* data, size_t blocks) {
+        const __m256i multiplier = _mm256_set1_epi64x(static_cast<long long>(kMultiplier));
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes_));
+        for (size_t i = 0; i < blocks; ++i, data += kBlockSize) {
+            __m256i elem = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            elem = MultiplyLow64(elem, multiplier);
+            elem = _mm256_xor_si256(elem, _mm256_srli_epi64(elem, kBitOffset));
+            elem = MultiplyLow64(elem, multiplier);
+            lanes = MultiplyLow64(_mm256_xor_si256(lanes, elem), multiplier);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes_), lanes);
+    }
+#else
+    void ProcessBlocks(const uint8_t* data, size_t blocks) {
+        for (size_t i = 0; i < blocks; ++i, data += kBlockSize) {
+            uint64_t elems[kLanes];
+            std::memcpy(elems, data, kBlockSize);
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                lanes_[lane] = (lanes_[lane] ^ Mix(elems[lane])) * kMultiplier;
+            }
+        }
+    }
+#endif
+
+    uint64_t seed_;
+    uint64_t lanes_[kLanes];
+    uint8_t buffer_[kBlockSize];
+    size_t buffered_ = 0;
+    uint64_t total_length_ = 0;
+};
+
+class WideStringHash {
+public:
+    WideStringHash() = default;
+
+    WideStringHash(size_t seed) : seed_(seed) {
+    }
+
+    size_t operator()(const std::string& value) const {
+        WideStringHasher hasher(seed_);
+        hasher.Update(value.data(), value.length());
+        return hasher.Finalize();
+    }
+
+private:
+    size_t seed_ = 0;
+};
+
+#endif
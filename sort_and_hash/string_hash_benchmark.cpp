@@ -0,0 +1,50 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include "../benchmark_utils.h"
+#include "string_hash.h"
+
+template <class Hash>
+double MeasureGigabytesPerSecond(const Hash& hash, const std::string& value, size_t& checksum) {
+    const size_t kTotalBytes = 1 << 28;
+    const size_t iterations = std::max<size_t>(kTotalBytes / value.size(), 1);
+
+    const double seconds = MeasureSeconds([&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            checksum += hash(value);
+        }
+    });
+    return static_cast<double>(iterations * value.size()) / seconds / (1 << 30);
+}
+
+int main() {
+    std::mt19937 generator;
+    std::uniform_int_distribution<int> distr(0, 255);
+    std::string data(1 << 20, ' ');
+    for (auto& symb : data) {
+        symb = static_cast<char>(distr(generator));
+    }
+
+    // Streaming in uneven pieces must give the one-shot value
+    WideStringHasher hasher(7);
+    for (size_t position = 0, piece = 1; position < data.size(); position += piece, piece = piece * 3 % 1000 + 1) {
+        hasher.Update(data.data() + position, std::min(piece, data.size() - position));
+    }
+    if (hasher.Finalize() != WideStringHash(7)(data)) {
+        std::cerr << "Streaming hash differs from one-shot hash\n";
+        return 1;
+    }
+
+    size_t checksum = 0;
+    StringHash string_hash(7);
+    WideStringHash wide_hash(7);
+    std::cout << "bytes\tStringHash_GB/s\tWideStringHash_GB/s\n";
+    for (size_t size = 8; size <= data.size(); size *= 2) {
+        const std::string value = data.substr(0, size);
+        std::cout << size << '\t' << MeasureGigabytesPerSecond(string_hash, value, checksum) << '\t'
+                  << MeasureGigabytesPerSecond(wide_hash, value, checksum) << '\n';
+    }
+    DoNotOptimize(checksum);
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SORT_AND_HASH_UNIVERSAL_HASH_FUNCTION_H
+#define SORT_AND_HASH_UNIVERSAL_HASH_FUNCTION_H
+
+#include <cstddef>
+#include <random>
+#include "multiply_shift_hash_function.h"
+
+class HashFunction {
+public:
+    HashFunction() = default;
+
+    HashFunction(size_t initial_value, size_t multiplier) : initial_value_(initial_value), multiplier_(multiplier) {
+    }
+
+    size_t operator()(int value) const {
+        return (initial_value_ + value * multiplier_) % kPrimeNumber;
+    }
+
+    template <class Generator>
+    static HashFunction MakeHash(Generator& generator) {
+        std::uniform_int_distribution<size_t> distr(1, kPrimeNumber - 1);
+        return HashFunction(distr(generator), distr(generator));
+    }
+
+private:
+    static const size_t kPrimeNumber = 2000000011;
+    size_t initial_value_ = 1345355;
+    size_t multiplier_ = 86456788;
+};
+
+#endif
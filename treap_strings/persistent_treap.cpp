@@ -0,0 +1,49 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "persistent_treap.h"
+
+template <class ValueT>
+class Op {
+public:
+    const static ValueT kNeutral = 0;
+
+    ValueT operator()(const ValueT& lhs, const ValueT& rhs) const {
+        return lhs + rhs;
+    }
+};
+
+// "+ x" and "- x" change the current set, "? l r v" asks the sum of keys in [l, r] as of version v,
+// version 0 is the empty set and every operation creates the next one
+int main() {
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    using SumTreap = PersistentTreap<int64_t, int64_t, Op<int64_t>>;
+
+    std::vector<SumTreap> versions(1);
+    int64_t num_operations;
+    std::cin >> num_operations;
+
+    for (int64_t i = 0; i < num_operations; ++i) {
+        std::string operation;
+        std::cin >> operation;
+        if (operation == "+" || operation == "-") {
+            int64_t value;
+            std::cin >> value;
+            versions.push_back(versions.back().Snapshot());
+            if (operation == "+") {
+                versions.back().Insert(value, value);
+            } else {
+                versions.back().Erase(value);
+            }
+        } else {
+            int64_t left, right;
+            size_t version;
+            std::cin >> left >> right >> version;
+            std::cout << versions[version].DoOper(left, right + 1) << '\n';
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#ifndef TREAP_STRINGS_PERSISTENT_TREAP_H
+#define TREAP_STRINGS_PERSISTENT_TREAP_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Treap whose nodes are never changed after they become reachable: Split and Merge copy
+// the nodes on their path, so every old root still describes its own version.
+// Nodes are shared through reference counting and are freed with the last version using them.
+template <class KeyT, class ValueT, class Op>
+class PersistentTreap {
+public:
+    PersistentTreap() = default;
+
+    // Snapshot is a copy, it costs one reference count increment
+    PersistentTreap Snapshot() const {
+        return *this;
+    }
+
+    bool Find(const KeyT& key) const {
+        const Node* node = root_.get();
+        while (node != nullptr) {
+            if (node->key == key) {
+                return true;
+            }
+            node = key < node->key ? node->left.get() : node->right.get();
+        }
+        return false;
+    }
+
+    bool Insert(const KeyT& key, const ValueT& value) {
+        if (Find(key)) {
+            return false;
+        }
+        auto [less_tree, greater_tree] = Split(root_, key);
+        NodePtr node = std::make_shared<const Node>(key, NextPriority(), value, nullptr, nullptr);
+        root_ = Merge(Merge(less_tree, node), greater_tree);
+        return true;
+    }
+
+    bool Erase(const KeyT& key) {
+        if (!Find(key)) {
+            return false;
+        }
+        root_ = Erase(root_, key);
+        return true;
+    }
+
+    uint64_t Size() const {
+        return Size(root_);
+    }
+
+    // Result of Op over keys in [left_bound, right_bound), walks two root-to-leaf paths and copies nothing
+    ValueT DoOper(const KeyT& left_bound, const KeyT& right_bound) const {
+        const Node* node = root_.get();
+        while (node != nullptr) {
+            if (node->key < left_bound) {
+                node = node->right.get();
+            } else if (!(node->key < right_bound)) {
+                node = node->left.get();
+            } else {
+                return Op()(Suffix(node->left.get(), left_bound), Op()(node->value, Prefix(node->right.get(), right_bound)));
+            }
+        }
+        return Op::kNeutral;
+    }
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        KeyT key;
+        uint64_t priority;
+        uint64_t size;
+
+        ValueT value;
+        ValueT result;
+
+        NodePtr left;
+        NodePtr right;
+
+        Node(const KeyT& key, uint64_t priority, const ValueT& value, NodePtr left, NodePtr right)
+            : key(key), priority(priority), size(1 + Size(left) + Size(right)), value(value),
+              result(Op()(Result(left), Op()(value, Result(right)))), left(std::move(left)), right(std::move(right)) {
+        }
+    };
+
+    NodePtr root_;
+    uint64_t priority_state_ = 0;
+
+    // SplitMix64 keeps the generator state to one word, so snapshots stay cheap to copy
+    uint64_t NextPriority() {
+        uint64_t value = (priority_state_ += 0x9e3779b97f4a7c15ULL);
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    static uint64_t Size(const NodePtr& node) {
+        return node ? node->size : 0;
+    }
+
+    static ValueT Result(const NodePtr& node) {
+        return node ? node->result : Op::kNeutral;
+    }
+
+    static NodePtr WithChildren(const NodePtr& node, NodePtr left, NodePtr right) {
+        return std::make_shared<const Node>(node->key, node->priority, node->value, std::move(left), std::move(right));
+    }
+
+    // Keys less than key go to the first tree
+    static std::pair<NodePtr, NodePtr> Split(const NodePtr& treap, const KeyT& key) {
+        if (!treap) {
+            return { nullptr, nullptr };
+        }
+        if (treap->key < key) {
+            auto two_trees = Split(treap->right, key);
+            return { WithChildren(treap, treap->left, std::move(two_trees.first)), std::move(two_trees.second) };
+        }
+        auto two_trees = Split(treap->left, key);
+        return { std::move(two_trees.first), WithChildren(treap, std::move(two_trees.second), treap->right) };
+    }
+
+    static NodePtr Merge(const NodePtr& left_root, const NodePtr& right_root) { // key(left) < key(right)
+        if (!left_root) {
+            return right_root;
+        }
+        if (!right_root) {
+            return left_root;
+        }
+        if (left_root->priority < right_root->priority) {
+            return WithChildren(right_root, Merge(left_root, right_root->left), right_root->right);
+        }
+        return WithChildren(left_root, left_root->left, Merge(left_root->right, right_root));
+    }
+
+    static NodePtr Erase(const NodePtr& node, const KeyT& key) {
+        if (node->key == key) {
+            return Merge(node->left, node->right);
+        }
+        if (key < node->key) {
+            return WithChildren(node, Erase(node->left, key), node->right);
+        }
+        return WithChildren(node, node->left, Erase(node->right, key));
+    }
+
+    // Op over keys not less than left_bound
+    static ValueT Suffix(const Node* node, const KeyT& left_bound) {
+        ValueT result = Op::kNeutral;
+        while (node != nullptr) {
+            if (node->key < left_bound) {
+                node = node->right.get();
+            } else {
+                result = Op()(Op()(node->value, Result(node->right)), result);
+                node = node->left.get();
+            }
+        }
+        return result;
+    }
+
+    // Op over keys less than right_bound
+    static ValueT Prefix(const Node* node, const KeyT& right_bound) {
+        ValueT result = Op::kNeutral;
+        while (node != nullptr) {
+            if (node->key < right_bound) {
+                result = Op()(result, Op()(Result(node->left), node->value));
+                node = node->right.get();
+            } else {
+                node = node->left.get();
+            }
+        }
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,989 @@
+#ifndef TREAP_STRINGS_TREAP_H
+#define TREAP_STRINGS_TREAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "treap_arena.h"
+
+// Key type of treaps ordered by position (implicit keys), as in rmq_rotate.cpp or fast_string_treap.cpp
+struct ImplicitKey {
+};
+
+struct NoValue {
+};
+
+// Aggregates are stateless: Neutral() and Combine() are chosen at compile time,
+// AddToResult() is only needed together with AddTag
+template <class T>
+struct SumAggregate {
+    static T Neutral() {
+        return T();
+    }
+
+    static T Combine(const T& lhs, const T& rhs) {
+        return lhs + rhs;
+    }
+
+    static T AddToResult(const T& result, const T& delta, uint32_t size) {
+        return result + delta * static_cast<T>(size);
+    }
+};
+
+template <class T>
+struct MinAggregate {
+    static T Neutral() {
+        return std::numeric_limits<T>::max();
+    }
+
+    static T Combine(const T& lhs, const T& rhs) {
+        return std::min(lhs, rhs);
+    }
+
+    static T AddToResult(const T& result, const T& delta, uint32_t) {
+        return result + delta;
+    }
+};
+
+template <class T>
+struct MaxAggregate {
+    static T Neutral() {
+        return std::numeric_limits<T>::lowest();
+    }
+
+    static T Combine(const T& lhs, const T& rhs) {
+        return std::max(lhs, rhs);
+    }
+
+    static T AddToResult(const T& result, const T& delta, uint32_t) {
+        return result + delta;
+    }
+};
+
+template <class T>
+struct NoAggregate {
+    static T Neutral() {
+        return T();
+    }
+
+    static T Combine(const T&, const T&) {
+        return T();
+    }
+};
+
+// Lazy tags: a tag stored in a node is already applied to the node and waits to be pushed to its children
+struct NoLazyTag {
+};
+
+struct ReverseTag {
+    bool reverse = false;
+
+    bool Empty() const {
+        return !reverse;
+    }
+
+    void Compose(const ReverseTag& newer) {
+        reverse ^= newer.reverse;
+    }
+
+    bool Reverses() const {
+        return reverse;
+    }
+
+    template <class Aggregate, class Value>
+    void Apply(Value&, Value&, uint32_t) const {
+    }
+};
+
+template <class T>
+struct AddTag {
+    T delta = T();
+
+    bool Empty() const {
+        return delta == T();
+    }
+
+    void Compose(const AddTag& newer) {
+        delta += newer.delta;
+    }
+
+    bool Reverses() const {
+        return false;
+    }
+
+    template <class Aggregate, class Value>
+    void Apply(Value& value, Value& result, uint32_t size) const {
+        value += delta;
+        result = Aggregate::AddToResult(result, delta, size);
+    }
+};
+
+template <class Key, class Priority, class Value>
+struct TreapElement {
+    Key key;
+    Priority priority;
+    Value value;
+};
+
+// Many treaps sharing one node arena. Roots are plain indices, so nodes move between
+// treaps by Split/Merge without copying (see swapper.cpp).
+template <class Key, class Value, class Aggregate, class LazyTag = NoLazyTag, class Priority = uint32_t>
+class TreapForest {
+public:
+    static constexpr bool kImplicit = std::is_same<Key, ImplicitKey>::value;
+    static constexpr bool kHasLazyTag = !std::is_same<LazyTag, NoLazyTag>::value;
+
+    // Keys of implicit treaps are positions
+    using KeyT = typename std::conditional<kImplicit, size_t, Key>::type;
+    using Element = TreapElement<Key, Priority, Value>;
+    using Index = uint32_t;
+    static constexpr Index kNull = 0;
+
+    void Reserve(size_t count) {
+        arena_.Reserve(count);
+    }
+
+    Index NewNode(const Key& key, const Priority& priority, const Value& value) {
+        return arena_.Allocate(key, priority, value);
+    }
+
+    // Frees a whole subtree
+    void Delete(Index root) {
+        std::vector<Index> stack;
+        if (root != kNull) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            Index node = stack.back();
+            stack.pop_back();
+            if (arena_[node].left != kNull) {
+                stack.push_back(arena_[node].left);
+            }
+            if (arena_[node].right != kNull) {
+                stack.push_back(arena_[node].right);
+            }
+            arena_.Free(node);
+        }
+    }
+
+    uint64_t Size(Index root) const {
+        return arena_[root].size;
+    }
+
+    const Value& Result(Index root) const {
+        return arena_[root].result;
+    }
+
+    const Key& KeyOf(Index node) const {
+        return arena_[node].key;
+    }
+
+    const Value& ValueOf(Index node) const {
+        return arena_[node].value;
+    }
+
+    const Priority& PriorityOf(Index node) const {
+        return arena_[node].priority;
+    }
+
+    Index Left(Index node) const {
+        return arena_[node].left;
+    }
+
+    Index Right(Index node) const {
+        return arena_[node].right;
+    }
+
+    void ApplyTag(Index node, const LazyTag& tag) {
+        if constexpr (kHasLazyTag) {
+            if (node == kNull) {
+                return;
+            }
+            Node& current = arena_[node];
+            tag.template Apply<Aggregate>(current.value, current.result, current.size);
+            if (tag.Reverses()) {
+                std::swap(current.left, current.right);
+            }
+            current.tag.Compose(tag);
+        }
+    }
+
+    void Push(Index node) {
+        if constexpr (kHasLazyTag) {
+            if (arena_[node].tag.Empty()) {
+                return;
+            }
+            const LazyTag tag = arena_[node].tag;
+            ApplyTag(arena_[node].left, tag);
+            ApplyTag(arena_[node].right, tag);
+            arena_[node].tag = LazyTag();
+        }
+    }
+
+    // The first count nodes in order go to the first tree
+    std::pair<Index, Index> SplitBySize(Index treap, uint64_t count) {
+        return SplitBySize(treap, count, path_);
+    }
+
+    // Keys less than key go to the first tree
+    std::pair<Index, Index> SplitByKey(Index treap, const Key& key) {
+        return SplitByKey(treap, key, path_);
+    }
+
+    // Positions for implicit treaps, keys otherwise
+    std::pair<Index, Index> Split(Index treap, const KeyT& key) {
+        if constexpr (kImplicit) {
+            return SplitBySize(treap, key);
+        } else {
+            return SplitByKey(treap, key);
+        }
+    }
+
+    Index Merge(Index left_root, Index right_root) { // key(left) < key(right)
+        return Merge(left_root, right_root, path_);
+    }
+
+    // Set operations on two keyed treaps of this forest, both are consumed.
+    // They are join based: the root with the higher priority splits the other treap, and the halves
+    // are combined recursively, which is O(m log(n / m + 1)) work for sizes m <= n.
+    // With threads_number > 1 the two halves of large subproblems run on separate threads.
+    // For equal keys the node of the first treap is kept.
+    Index Union(Index first, Index second, size_t threads_number = 1) {
+        return RunSetOperation(&TreapForest::UnionTask, first, second, threads_number);
+    }
+
+    Index Intersect(Index first, Index second, size_t threads_number = 1) {
+        return RunSetOperation(&TreapForest::IntersectTask, first, second, threads_number);
+    }
+
+    // Keys of first that are not in second
+    Index Difference(Index first, Index second, size_t threads_number = 1) {
+        return RunSetOperation(&TreapForest::DifferenceTask, first, second, threads_number);
+    }
+
+    // Recursive versions of the splits and Merge, kept for treap_split_benchmark.cpp
+    std::pair<Index, Index> SplitBySizeRecursive(Index treap, uint64_t count) {
+        if (treap == kNull) {
+            return { kNull, kNull };
+        }
+        Push(treap);
+        const uint64_t left_size = Size(arena_[treap].left);
+        if (left_size < count) {
+            auto two_trees = SplitBySizeRecursive(arena_[treap].right, count - left_size - 1);
+            arena_[treap].right = two_trees.first;
+            UpdateNode(treap);
+            return { treap, two_trees.second };
+        }
+        auto two_trees = SplitBySizeRecursive(arena_[treap].left, count);
+        arena_[treap].left = two_trees.second;
+        UpdateNode(treap);
+        return { two_trees.first, treap };
+    }
+
+    std::pair<Index, Index> SplitByKeyRecursive(Index treap, const Key& key) {
+        if (treap == kNull) {
+            return { kNull, kNull };
+        }
+        Push(treap);
+        if (arena_[treap].key < key) {
+            auto two_trees = SplitByKeyRecursive(arena_[treap].right, key);
+            arena_[treap].right = two_trees.first;
+            UpdateNode(treap);
+            return { treap, two_trees.second };
+        }
+        auto two_trees = SplitByKeyRecursive(arena_[treap].left, key);
+        arena_[treap].left = two_trees.second;
+        UpdateNode(treap);
+        return { two_trees.first, treap };
+    }
+
+    Index MergeRecursive(Index left_root, Index right_root) { // key(left) < key(right)
+        if (left_root == kNull) {
+            return right_root;
+        }
+        if (right_root == kNull) {
+            return left_root;
+        }
+        if (arena_[left_root].priority < arena_[right_root].priority) {
+            Push(right_root);
+            const Index merged = MergeRecursive(left_root, arena_[right_root].left);
+            arena_[right_root].left = merged;
+            UpdateNode(right_root);
+            return right_root;
+        }
+        Push(left_root);
+        const Index merged = MergeRecursive(arena_[left_root].right, right_root);
+        arena_[left_root].right = merged;
+        UpdateNode(left_root);
+        return left_root;
+    }
+
+    // Builds a treap from elements in order in O(n), keeping the rightmost path on a stack.
+    // With random access iterators and threads_number > 1, chunks are built on separate threads
+    // into preallocated nodes and then merged along their spines.
+    template <class FwdIt>
+    Index BuildFromSorted(FwdIt begin, FwdIt end, size_t threads_number = 1) {
+        const size_t count = std::distance(begin, end);
+        const Index first_index = arena_.AllocateRange(count);
+        using Category = typename std::iterator_traits<FwdIt>::iterator_category;
+        if constexpr (std::is_base_of<std::random_access_iterator_tag, Category>::value) {
+            threads_number = std::max<size_t>(1, std::min(threads_number, count / kParallelGrain));
+            if (threads_number > 1) {
+                std::vector<Index> roots(threads_number);
+                std::vector<std::thread> workers;
+                for (size_t i = 0; i < threads_number; ++i) {
+                    workers.emplace_back([&, i]() {
+                        const size_t chunk_begin = count * i / threads_number;
+                        const size_t chunk_end = count * (i + 1) / threads_number;
+                        roots[i] = BuildRange(begin + chunk_begin, begin + chunk_end, first_index + chunk_begin);
+                    });
+                }
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+                Index root = kNull;
+                for (Index chunk_root : roots) {
+                    root = Merge(root, chunk_root);
+                }
+                return root;
+            }
+        }
+        return BuildRange(begin, end, first_index);
+    }
+
+    // Copies a treap of another forest, keeping its shape
+    Index CopyFrom(const TreapForest& other, Index other_root) {
+        if (other_root == kNull) {
+            return kNull;
+        }
+        const Index root = arena_.Allocate(other.arena_[other_root]);
+        std::vector<std::pair<Index, Index>> stack = { { root, other_root } };
+        while (!stack.empty()) {
+            auto [node, other_node] = stack.back();
+            stack.pop_back();
+            const Index other_left = other.arena_[other_node].left;
+            const Index other_right = other.arena_[other_node].right;
+            if (other_left != kNull) {
+                const Index left = arena_.Allocate(other.arena_[other_left]);
+                arena_[node].left = left;
+                stack.emplace_back(left, other_left);
+            }
+            if (other_right != kNull) {
+                const Index right = arena_.Allocate(other.arena_[other_right]);
+                arena_[node].right = right;
+                stack.emplace_back(right, other_right);
+            }
+        }
+        return root;
+    }
+
+    void Clear() {
+        arena_.Clear();
+    }
+
+private:
+    // Fields read on every step of a descent come first
+    struct Node {
+        Key key;
+        Value result;
+        Priority priority;
+        uint32_t size;
+        Index left;
+        Index right;
+        Value value;
+        LazyTag tag;
+
+        Node() : key(), result(Aggregate::Neutral()), priority(), size(0), left(kNull), right(kNull), value(), tag() {
+        }
+
+        Node(const Key& key, const Priority& priority, const Value& value)
+            : key(key), result(value), priority(priority), size(1), left(kNull), right(kNull), value(value), tag() {
+        }
+    };
+
+    // The sentinel has size 0 and a neutral result, so children need no null checks
+    void UpdateNode(Index index) {
+        Node& node = arena_[index];
+        const Node& left = arena_[node.left];
+        const Node& right = arena_[node.right];
+        node.size = 1 + left.size + right.size;
+        node.result = Aggregate::Combine(Aggregate::Combine(left.result, node.value), right.result);
+    }
+
+    // Subproblems smaller than this are not worth a thread
+    static constexpr size_t kParallelGrain = 1 << 14;
+
+    // Splits and Merge walk down once, hanging nodes into the open child slots of the result trees,
+    // then update sizes bottom-up along the remembered path, so depth is not limited by the call stack
+    std::pair<Index, Index> SplitBySize(Index treap, uint64_t count, std::vector<Index>& path) {
+        Index left_root = kNull;
+        Index right_root = kNull;
+        Index* left_slot = &left_root;
+        Index* right_slot = &right_root;
+        path.clear();
+        while (treap != kNull) {
+            Push(treap);
+            path.push_back(treap);
+            const uint64_t left_size = Size(arena_[treap].left);
+            if (left_size < count) {
+                count -= left_size + 1;
+                *left_slot = treap;
+                left_slot = &arena_[treap].right;
+                treap = arena_[treap].right;
+            } else {
+                *right_slot = treap;
+                right_slot = &arena_[treap].left;
+                treap = arena_[treap].left;
+            }
+        }
+        *left_slot = kNull;
+        *right_slot = kNull;
+        UpdatePath(path);
+        return { left_root, right_root };
+    }
+
+    std::pair<Index, Index> SplitByKey(Index treap, const Key& key, std::vector<Index>& path) {
+        Index left_root = kNull;
+        Index right_root = kNull;
+        Index* left_slot = &left_root;
+        Index* right_slot = &right_root;
+        path.clear();
+        while (treap != kNull) {
+            Push(treap);
+            path.push_back(treap);
+            if (arena_[treap].key < key) {
+                *left_slot = treap;
+                left_slot = &arena_[treap].right;
+                treap = arena_[treap].right;
+            } else {
+                *right_slot = treap;
+                right_slot = &arena_[treap].left;
+                treap = arena_[treap].left;
+            }
+        }
+        *left_slot = kNull;
+        *right_slot = kNull;
+        UpdatePath(path);
+        return { left_root, right_root };
+    }
+
+    // Like SplitByKey, but a node equal to key is taken out as the middle tree of one node
+    std::tuple<Index, Index, Index> SplitExact(Index treap, const Key& key, std::vector<Index>& path) {
+        Index left_root = kNull;
+        Index right_root = kNull;
+        Index* left_slot = &left_root;
+        Index* right_slot = &right_root;
+        Index equal = kNull;
+        path.clear();
+        while (treap != kNull) {
+            Push(treap);
+            if (arena_[treap].key < key) {
+                path.push_back(treap);
+                *left_slot = treap;
+                left_slot = &arena_[treap].right;
+                treap = arena_[treap].right;
+            } else if (key < arena_[treap].key) {
+                path.push_back(treap);
+                *right_slot = treap;
+                right_slot = &arena_[treap].left;
+                treap = arena_[treap].left;
+            } else {
+                equal = treap;
+                *left_slot = arena_[treap].left;
+                *right_slot = arena_[treap].right;
+                arena_[treap].left = kNull;
+                arena_[treap].right = kNull;
+                UpdateNode(treap);
+                break;
+            }
+        }
+        if (equal == kNull) {
+            *left_slot = kNull;
+            *right_slot = kNull;
+        }
+        UpdatePath(path);
+        return { left_root, equal, right_root };
+    }
+
+    Index Merge(Index left_root, Index right_root, std::vector<Index>& path) {
+        Index root = kNull;
+        Index* slot = &root;
+        path.clear();
+        while (left_root != kNull && right_root != kNull) {
+            if (arena_[left_root].priority < arena_[right_root].priority) {
+                Push(right_root);
+                path.push_back(right_root);
+                *slot = right_root;
+                slot = &arena_[right_root].left;
+                right_root = arena_[right_root].left;
+            } else {
+                Push(left_root);
+                path.push_back(left_root);
+                *slot = left_root;
+                slot = &arena_[left_root].right;
+                left_root = arena_[left_root].right;
+            }
+        }
+        *slot = left_root != kNull ? left_root : right_root;
+        UpdatePath(path);
+        return root;
+    }
+
+    // Scratch space of one thread of a set operation. Dropped nodes are collected
+    // and freed at the end, because the free list is not thread safe.
+    struct SetTaskState {
+        std::vector<Index> path;
+        std::vector<Index> dropped;
+    };
+
+    using SetTask = Index (TreapForest::*)(Index, Index, size_t, SetTaskState&);
+
+    Index RunSetOperation(SetTask task, Index first, Index second, size_t threads_number) {
+        size_t fork_depth = 0;
+        while ((size_t(1) << fork_depth) < threads_number) {
+            ++fork_depth;
+        }
+        SetTaskState state;
+        const Index root = (this->*task)(first, second, fork_depth, state);
+        for (Index node : state.dropped) {
+            Delete(node);
+        }
+        return root;
+    }
+
+    // Runs both halves, the right one on a new thread while forks are left and the work is large
+    template <class Function>
+    std::pair<Index, Index> RunHalves(Function half, size_t fork_depth, size_t work, SetTaskState& state) {
+        if (fork_depth == 0 || work < kParallelGrain) {
+            const Index left = half(false, fork_depth, state);
+            const Index right = half(true, fork_depth, state);
+            return { left, right };
+        }
+        SetTaskState right_state;
+        auto right_future = std::async(std::launch::async, [&]() {
+            return half(true, fork_depth - 1, right_state);
+        });
+        const Index left = half(false, fork_depth - 1, state);
+        const Index right = right_future.get();
+        state.dropped.insert(state.dropped.end(), right_state.dropped.begin(), right_state.dropped.end());
+        return { left, right };
+    }
+
+    // Detaches a node from its children, so that dropping it does not free them
+    void Drop(Index node, SetTaskState& state) {
+        arena_[node].left = kNull;
+        arena_[node].right = kNull;
+        state.dropped.push_back(node);
+    }
+
+    Index Attach(Index node, Index left, Index right) {
+        arena_[node].left = left;
+        arena_[node].right = right;
+        UpdateNode(node);
+        return node;
+    }
+
+    Index UnionTask(Index first, Index second, size_t fork_depth, SetTaskState& state) {
+        if (first == kNull) {
+            return second;
+        }
+        if (second == kNull) {
+            return first;
+        }
+        const bool swapped = arena_[first].priority < arena_[second].priority;
+        if (swapped) {
+            std::swap(first, second);
+        }
+        Push(first);
+        auto [less, equal, greater] = SplitExact(second, arena_[first].key, state.path);
+        if (equal != kNull) {
+            if (swapped) {
+                arena_[first].value = arena_[equal].value;
+            }
+            Drop(equal, state);
+        }
+        const Index first_left = arena_[first].left;
+        const Index first_right = arena_[first].right;
+        auto [left, right] = RunHalves(
+            [&, less = less, greater = greater](bool is_right, size_t depth, SetTaskState& half_state) {
+                return is_right ? UnionTask(first_right, greater, depth, half_state)
+                                : UnionTask(first_left, less, depth, half_state);
+            },
+            fork_depth, Size(first) + Size(second), state);
+        return Attach(first, left, right);
+    }
+
+    Index IntersectTask(Index first, Index second, size_t fork_depth, SetTaskState& state) {
+        if (first == kNull || second == kNull) {
+            if (first != kNull) {
+                state.dropped.push_back(first);
+            }
+            if (second != kNull) {
+                state.dropped.push_back(second);
+            }
+            return kNull;
+        }
+        const bool swapped = arena_[first].priority < arena_[second].priority;
+        if (swapped) {
+            std::swap(first, second);
+        }
+        Push(first);
+        auto [less, equal, greater] = SplitExact(second, arena_[first].key, state.path);
+        const Index first_left = arena_[first].left;
+        const Index first_right = arena_[first].right;
+        const size_t work = Size(first) + Size(second);
+        auto [left, right] = RunHalves(
+            [&, less = less, greater = greater](bool is_right, size_t depth, SetTaskState& half_state) {
+                return is_right ? IntersectTask(first_right, greater, depth, half_state)
+                                : IntersectTask(first_left, less, depth, half_state);
+            },
+            fork_depth, work, state);
+        if (equal == kNull) {
+            Drop(first, state);
+            return Merge(left, right, state.path);
+        }
+        if (swapped) {
+            arena_[first].value = arena_[equal].value;
+        }
+        Drop(equal, state);
+        return Attach(first, left, right);
+    }
+
+    Index DifferenceTask(Index first, Index second, size_t fork_depth, SetTaskState& state) {
+        if (first == kNull || second == kNull) {
+            if (second != kNull) {
+                state.dropped.push_back(second);
+            }
+            return first;
+        }
+        Push(second);
+        auto [less, equal, greater] = SplitExact(first, arena_[second].key, state.path);
+        if (equal != kNull) {
+            Drop(equal, state);
+        }
+        const Index second_left = arena_[second].left;
+        const Index second_right = arena_[second].right;
+        const size_t work = Size(first) + Size(second);
+        Drop(second, state);
+        auto [left, right] = RunHalves(
+            [&, less = less, greater = greater](bool is_right, size_t depth, SetTaskState& half_state) {
+                return is_right ? DifferenceTask(greater, second_right, depth, half_state)
+                                : DifferenceTask(less, second_left, depth, half_state);
+            },
+            fork_depth, work, state);
+        return Merge(left, right, state.path);
+    }
+
+    // Builds over nodes first_index, first_index + 1, ... that are already allocated
+    template <class FwdIt>
+    Index BuildRange(FwdIt begin, FwdIt end, Index first_index) {
+        std::vector<Index> right_path;
+        Index new_node = first_index;
+        for (auto it = begin; it != end; ++it, ++new_node) {
+            arena_[new_node] = Node(it->key, it->priority, it->value);
+            Index last_popped = kNull;
+            while (!right_path.empty() && arena_[right_path.back()].priority < arena_[new_node].priority) {
+                last_popped = right_path.back();
+                right_path.pop_back();
+                UpdateNode(last_popped);
+            }
+            arena_[new_node].left = last_popped;
+            if (!right_path.empty()) {
+                arena_[right_path.back()].right = new_node;
+            }
+            right_path.push_back(new_node);
+        }
+
+        Index root = kNull;
+        while (!right_path.empty()) {
+            root = right_path.back();
+            right_path.pop_back();
+            UpdateNode(root);
+        }
+        return root;
+    }
+
+    void UpdatePath(const std::vector<Index>& path) {
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            UpdateNode(*it);
+        }
+    }
+
+    NodeArena<Node> arena_;
+    // Nodes visited by the last Split or Merge, the buffer is reused between calls
+    std::vector<Index> path_;
+};
+
+// One treap over a TreapForest. Aggregation and lazy propagation are template policies,
+// nothing but the nodes themselves is passed down the recursion.
+template <class Key, class Value = NoValue, class Aggregate = NoAggregate<Value>, class LazyTag = NoLazyTag,
+          class Priority = uint32_t>
+class Treap {
+public:
+    using Forest = TreapForest<Key, Value, Aggregate, LazyTag, Priority>;
+    using KeyT = typename Forest::KeyT;
+    using Element = typename Forest::Element;
+    using Index = typename Forest::Index;
+
+    Treap() = default;
+
+    // Elements of implicit treaps are taken in order, keyed ones are built in O(n) when sorted,
+    // on threads_number threads for random access iterators
+    template <class FwdIt>
+    Treap(FwdIt begin, FwdIt end, size_t threads_number = 1) {
+        if constexpr (Forest::kImplicit) {
+            root_ = forest_.BuildFromSorted(begin, end, threads_number);
+        } else {
+            if (std::is_sorted(begin, end, [](const auto& x, const auto& y) { return x.key < y.key; })) {
+                root_ = forest_.BuildFromSorted(begin, end, threads_number);
+                return;
+            }
+            for (auto it = begin; it != end; ++it) {
+                Insert(it->key, it->priority, it->value);
+            }
+        }
+    }
+
+    void Reserve(size_t count) {
+        forest_.Reserve(count);
+    }
+
+    uint64_t Size() const {
+        return forest_.Size(root_);
+    }
+
+    bool Find(const KeyT& key) const {
+        if constexpr (Forest::kImplicit) {
+            return key < Size();
+        } else {
+            Index node = root_;
+            while (node != Forest::kNull) {
+                if (forest_.KeyOf(node) == key) {
+                    return true;
+                }
+                node = key < forest_.KeyOf(node) ? forest_.Left(node) : forest_.Right(node);
+            }
+            return false;
+        }
+    }
+
+    // Keyed treaps ignore duplicates, implicit ones insert before position key
+    bool Insert(const KeyT& key, const Priority& priority, const Value& value = Value()) {
+        if constexpr (Forest::kImplicit) {
+            auto [less_tree, greater_tree] = forest_.Split(root_, key);
+            const Index node = forest_.NewNode(ImplicitKey(), priority, value);
+            root_ = forest_.Merge(forest_.Merge(less_tree, node), greater_tree);
+        } else {
+            if (Find(key)) {
+                return false;
+            }
+            auto [less_tree, greater_tree] = forest_.Split(root_, key);
+            const Index node = forest_.NewNode(key, priority, value);
+            root_ = forest_.Merge(forest_.Merge(less_tree, node), greater_tree);
+        }
+        return true;
+    }
+
+    bool Erase(const KeyT& key) {
+        if (!Find(key)) {
+            return false;
+        }
+        auto [less_tree, ge_tree] = forest_.Split(root_, key);
+        auto [equal_tree, greater_tree] = forest_.SplitBySize(ge_tree, 1);
+        forest_.Delete(equal_tree);
+        root_ = forest_.Merge(less_tree, greater_tree);
+        return true;
+    }
+
+    std::pair<bool, KeyT> Next(const KeyT& key) const {
+        static_assert(!Forest::kImplicit, "Next needs keys");
+        Index upper_bound = Forest::kNull;
+        for (Index node = root_; node != Forest::kNull;) {
+            if (key < forest_.KeyOf(node)) {
+                upper_bound = node;
+                node = forest_.Left(node);
+            } else {
+                node = forest_.Right(node);
+            }
+        }
+        return ExistKey(upper_bound);
+    }
+
+    std::pair<bool, KeyT> Prev(const KeyT& key) const {
+        static_assert(!Forest::kImplicit, "Prev needs keys");
+        Index lower_bound = Forest::kNull;
+        for (Index node = root_; node != Forest::kNull;) {
+            if (forest_.KeyOf(node) < key) {
+                lower_bound = node;
+                node = forest_.Right(node);
+            } else {
+                node = forest_.Left(node);
+            }
+        }
+        return ExistKey(lower_bound);
+    }
+
+    // k is 1-based
+    std::pair<bool, KeyT> KStatistic(uint64_t k) const {
+        static_assert(!Forest::kImplicit, "Positions of implicit treaps are their keys");
+        const Index node = KthNode(k);
+        return ExistKey(node);
+    }
+
+    std::pair<bool, Value> KthValue(uint64_t k) {
+        const Index node = KthNode(k);
+        if (node == Forest::kNull) {
+            return { false, Value() };
+        }
+        return { true, forest_.ValueOf(node) };
+    }
+
+    // Aggregate over keys (positions for implicit treaps) in [left_bound, right_bound)
+    Value DoOper(const KeyT& left_bound, const KeyT& right_bound) {
+        auto [less_tree, rest] = forest_.Split(root_, left_bound);
+        auto [middle, greater_tree] = SplitRest(rest, left_bound, right_bound);
+        const Value answer = forest_.Result(middle);
+        root_ = forest_.Merge(less_tree, forest_.Merge(middle, greater_tree));
+        return answer;
+    }
+
+    void ApplyToRange(const KeyT& left_bound, const KeyT& right_bound, const LazyTag& tag) {
+        auto [less_tree, rest] = forest_.Split(root_, left_bound);
+        auto [middle, greater_tree] = SplitRest(rest, left_bound, right_bound);
+        forest_.ApplyTag(middle, tag);
+        root_ = forest_.Merge(less_tree, forest_.Merge(middle, greater_tree));
+    }
+
+    // Set operations leave the result in this treap and empty other; for equal keys values of this treap are kept
+    void Union(Treap&& other, size_t threads_number = 1) {
+        const Index other_root = Adopt(std::move(other));
+        root_ = forest_.Union(root_, other_root, threads_number);
+    }
+
+    void Intersect(Treap&& other, size_t threads_number = 1) {
+        const Index other_root = Adopt(std::move(other));
+        root_ = forest_.Intersect(root_, other_root, threads_number);
+    }
+
+    void Difference(Treap&& other, size_t threads_number = 1) {
+        const Index other_root = Adopt(std::move(other));
+        root_ = forest_.Difference(root_, other_root, threads_number);
+    }
+
+    // Calls function(key, left_key, right_key, parent_key) for every node in preorder,
+    // missing relatives are passed as nullptr
+    template <class Function>
+    void Traverse(Function function) const {
+        std::vector<std::pair<Index, Index>> stack;
+        if (root_ != Forest::kNull) {
+            stack.emplace_back(root_, Forest::kNull);
+        }
+        while (!stack.empty()) {
+            auto [node, parent] = stack.back();
+            stack.pop_back();
+            const Index left = forest_.Left(node);
+            const Index right = forest_.Right(node);
+            function(forest_.KeyOf(node), KeyPointer(left), KeyPointer(right), KeyPointer(parent));
+            if (right != Forest::kNull) {
+                stack.emplace_back(right, node);
+            }
+            if (left != Forest::kNull) {
+                stack.emplace_back(left, node);
+            }
+        }
+    }
+
+    void Clear() {
+        forest_.Clear();
+        root_ = Forest::kNull;
+    }
+
+private:
+    Forest forest_;
+    Index root_ = Forest::kNull;
+
+    // Brings the nodes of other into this forest, copying the smaller of the two treaps
+    Index Adopt(Treap&& other) {
+        static_assert(!Forest::kImplicit, "Set operations need keys");
+        Index other_root = Forest::kNull;
+        if (other.Size() <= Size()) {
+            other_root = forest_.CopyFrom(other.forest_, other.root_);
+        } else {
+            const Index root_copy = other.forest_.CopyFrom(forest_, root_);
+            forest_ = std::move(other.forest_);
+            root_ = root_copy;
+            other_root = other.root_;
+        }
+        other.Clear();
+        return other_root;
+    }
+
+    std::pair<Index, Index> SplitRest(Index rest, const KeyT& left_bound, const KeyT& right_bound) {
+        if constexpr (Forest::kImplicit) {
+            return forest_.SplitBySize(rest, right_bound - left_bound);
+        } else {
+            return forest_.SplitByKey(rest, right_bound);
+        }
+    }
+
+    Index KthNode(uint64_t k) const {
+        Index node = root_;
+        while (node != Forest::kNull) {
+            const uint64_t left_size = forest_.Size(forest_.Left(node));
+            if (left_size + 1 == k) {
+                return node;
+            }
+            if (left_size + 1 < k) {
+                k -= left_size + 1;
+                node = forest_.Right(node);
+            } else {
+                node = forest_.Left(node);
+            }
+        }
+        return Forest::kNull;
+    }
+
+    // Lazy tags may reorder children, so the walk to the k-th node pushes them first
+    Index KthNode(uint64_t k) {
+        if constexpr (Forest::kHasLazyTag) {
+            Index node = root_;
+            while (node != Forest::kNull) {
+                forest_.Push(node);
+                const uint64_t left_size = forest_.Size(forest_.Left(node));
+                if (left_size + 1 == k) {
+                    return node;
+                }
+                if (left_size + 1 < k) {
+                    k -= left_size + 1;
+                    node = forest_.Right(node);
+                } else {
+                    node = forest_.Left(node);
+                }
+            }
+            return Forest::kNull;
+        } else {
+            return static_cast<const Treap*>(this)->KthNode(k);
+        }
+    }
+
+    std::pair<bool, KeyT> ExistKey(Index node) const {
+        if (node != Forest::kNull) {
+            return { true, forest_.KeyOf(node) };
+        }
+        return { false, KeyT() };
+    }
+
+    const Key* KeyPointer(Index node) const {
+        return node == Forest::kNull ? nullptr : &forest_.KeyOf(node);
+    }
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef TREAP_STRINGS_TREAP_ARENA_H
+#define TREAP_STRINGS_TREAP_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Nodes live in one vector and refer to each other by 32-bit indices.
+// Index 0 is a sentinel standing for the empty tree, so it must be a valid "empty" node.
+// Erased nodes go to a free list; Clear() drops everything at once instead of walking the tree.
+template <class NodeT>
+class NodeArena {
+public:
+    using Index = uint32_t;
+    static constexpr Index kNull = 0;
+
+    NodeArena() : nodes_(1) {
+    }
+
+    NodeT& operator[](Index index) {
+        return nodes_[index];
+    }
+
+    const NodeT& operator[](Index index) const {
+        return nodes_[index];
+    }
+
+    template <class... Args>
+    Index Allocate(Args&&... args) {
+        if (!free_.empty()) {
+            Index index = free_.back();
+            free_.pop_back();
+            nodes_[index] = NodeT(std::forward<Args>(args)...);
+            return index;
+        }
+        nodes_.emplace_back(std::forward<Args>(args)...);
+        return static_cast<Index>(nodes_.size() - 1);
+    }
+
+    // Appends count default nodes and returns the first of them; they are not reused from the free list,
+    // so the caller may fill the range from several threads
+    Index AllocateRange(size_t count) {
+        const Index first = static_cast<Index>(nodes_.size());
+        nodes_.resize(nodes_.size() + count);
+        return first;
+    }
+
+    void Free(Index index) {
+        free_.push_back(index);
+    }
+
+    void Reserve(size_t count) {
+        nodes_.reserve(count + 1);
+    }
+
+    void Clear() {
+        nodes_.resize(1);
+        free_.clear();
+    }
+
+    size_t Allocated() const {
+        return nodes_.size() - 1 - free_.size();
+    }
+
+private:
+    std::vector<NodeT> nodes_;
+    std::vector<Index> free_;
+};
+
+#endif
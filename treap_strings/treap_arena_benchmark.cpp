@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "treap.h"
+
+int main() {
+    size_t keys_number;
+    std::cin >> keys_number;
+
+    std::mt19937_64 generator;
+    std::vector<int64_t> keys(keys_number);
+    for (auto& key : keys) {
+        key = static_cast<int64_t>(generator() >> 1);
+    }
+    const size_t queries_number = keys_number / 10;
+
+    Treap<int64_t, int64_t, SumAggregate<int64_t>> treap;
+    int64_t checksum = 0;
+    double treap_insert = MeasureSeconds([&]() {
+        treap.Reserve(keys.size());
+        for (auto key : keys) {
+            treap.Insert(key, static_cast<uint32_t>(generator()), key & 0xff);
+        }
+    });
+    double treap_query = MeasureSeconds([&]() {
+        for (size_t i = 0; i < queries_number; ++i) {
+            auto [left, right] = std::minmax(keys[i], keys[keys.size() - 1 - i]);
+            checksum += treap.DoOper(left, right);
+        }
+    });
+    double treap_erase = MeasureSeconds([&]() {
+        for (auto key : keys) {
+            treap.Erase(key);
+        }
+    });
+
+    std::set<int64_t> set;
+    double set_insert = MeasureSeconds([&]() {
+        for (auto key : keys) {
+            set.insert(key);
+        }
+    });
+    double set_erase = MeasureSeconds([&]() {
+        for (auto key : keys) {
+            set.erase(key);
+        }
+    });
+
+    std::cout << "Treap:    insert " << treap_insert << " s, " << queries_number << " range queries "
+              << treap_query << " s, erase " << treap_erase << " s\n";
+    std::cout << "std::set: insert " << set_insert << " s, erase " << set_erase << " s\n";
+    DoNotOptimize(checksum);
+
+    return 0;
+}
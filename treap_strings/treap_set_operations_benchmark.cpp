@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "treap.h"
+
+using KeySet = Treap<int64_t, int64_t, SumAggregate<int64_t>>;
+
+// Every step-th key starting from offset, so sets built with different offsets partly overlap
+std::vector<KeySet::Element> SortedKeys(size_t count, int64_t step, int64_t offset, std::mt19937& generator) {
+    std::vector<KeySet::Element> elements(count);
+    for (size_t i = 0; i < count; ++i) {
+        elements[i] = { offset + static_cast<int64_t>(i) * step, static_cast<uint32_t>(generator()), 1 };
+    }
+    return elements;
+}
+
+int main() {
+    size_t keys_number;
+    std::cin >> keys_number;
+    const size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 generator;
+    const auto large = SortedKeys(keys_number, 2, 0, generator);
+    const auto small = SortedKeys(keys_number / 100, 3, 1, generator);
+
+    for (size_t threads_number : { size_t(1), hardware_threads }) {
+        KeySet built;
+        double build = MeasureSeconds([&]() {
+            built = KeySet(large.begin(), large.end(), threads_number);
+        });
+
+        double union_seconds = 0;
+        double intersect_seconds = 0;
+        double difference_seconds = 0;
+        uint64_t sizes[3];
+        for (int operation = 0; operation < 3; ++operation) {
+            KeySet first(large.begin(), large.end(), threads_number);
+            KeySet second(small.begin(), small.end(), threads_number);
+            if (operation == 0) {
+                union_seconds = MeasureSeconds([&]() {
+                    first.Union(std::move(second), threads_number);
+                });
+            } else if (operation == 1) {
+                intersect_seconds = MeasureSeconds([&]() {
+                    first.Intersect(std::move(second), threads_number);
+                });
+            } else {
+                difference_seconds = MeasureSeconds([&]() {
+                    first.Difference(std::move(second), threads_number);
+                });
+            }
+            sizes[operation] = first.Size();
+        }
+
+        std::cout << threads_number << " threads: build " << keys_number << " keys " << build << " s, union with "
+                  << small.size() << " keys " << union_seconds << " s, intersect " << intersect_seconds
+                  << " s, difference " << difference_seconds << " s\n";
+        DoNotOptimize(built.Size() + sizes[0] + sizes[1] + sizes[2]);
+    }
+
+    return 0;
+}
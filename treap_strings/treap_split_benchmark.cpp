@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../benchmark_utils.h"
+#include "treap.h"
+
+using Forest = TreapForest<ImplicitKey, int64_t, SumAggregate<int64_t>>;
+
+// Moves [left, right) to the front, as Swapper and rmq_rotate do with their segments
+template <bool kRecursive>
+Forest::Index MoveToFront(Forest& forest, Forest::Index root, uint64_t left, uint64_t right) {
+    if constexpr (kRecursive) {
+        auto [inf_left, left_inf] = forest.SplitBySizeRecursive(root, left);
+        auto [left_right, right_inf] = forest.SplitBySizeRecursive(left_inf, right - left);
+        return forest.MergeRecursive(left_right, forest.MergeRecursive(inf_left, right_inf));
+    } else {
+        auto [inf_left, left_inf] = forest.SplitBySize(root, left);
+        auto [left_right, right_inf] = forest.SplitBySize(left_inf, right - left);
+        return forest.Merge(left_right, forest.Merge(inf_left, right_inf));
+    }
+}
+
+template <bool kRecursive>
+double RunMoves(const std::vector<Forest::Element>& elements, const std::vector<std::pair<uint64_t, uint64_t>>& moves,
+                int64_t& checksum) {
+    Forest forest;
+    forest.Reserve(elements.size());
+    Forest::Index root = forest.BuildFromSorted(elements.begin(), elements.end());
+    double seconds = MeasureSeconds([&]() {
+        for (auto [left, right] : moves) {
+            root = MoveToFront<kRecursive>(forest, root, left, right);
+        }
+    });
+    // The first element after all moves depends on every move
+    auto [first, rest] = forest.SplitBySize(root, 1);
+    checksum = forest.Result(first) * 1000003 + forest.Result(rest);
+    return seconds;
+}
+
+int main() {
+    size_t elements_number;
+    std::cin >> elements_number;
+
+    std::mt19937_64 generator;
+    std::vector<Forest::Element> elements(elements_number);
+    for (size_t i = 0; i < elements_number; ++i) {
+        elements[i].priority = static_cast<uint32_t>(generator());
+        elements[i].value = static_cast<int64_t>(i);
+    }
+    std::vector<std::pair<uint64_t, uint64_t>> moves(elements_number);
+    for (auto& move : moves) {
+        move = std::minmax(generator() % (elements_number + 1), generator() % (elements_number + 1));
+    }
+
+    int64_t recursive_checksum = 0;
+    int64_t iterative_checksum = 0;
+    double recursive = RunMoves<true>(elements, moves, recursive_checksum);
+    double iterative = RunMoves<false>(elements, moves, iterative_checksum);
+    std::cout << "random priorities, " << moves.size() << " moves: recursive " << recursive << " s, iterative "
+              << iterative << " s\n";
+
+    // Increasing priorities turn the treap into a left path as deep as the input:
+    // every split and merge below walks all of it
+    const size_t path_length = std::min<size_t>(elements_number, 100000);
+    std::vector<Forest::Element> path(elements.begin(), elements.begin() + path_length);
+    for (size_t i = 0; i < path_length; ++i) {
+        path[i].priority = static_cast<uint32_t>(i);
+    }
+    const size_t path_moves_number = 100;
+    std::vector<std::pair<uint64_t, uint64_t>> path_moves(path_moves_number, { 1, path_length });
+    int64_t recursive_path_checksum = 0;
+    int64_t iterative_path_checksum = 0;
+    double recursive_path = RunMoves<true>(path, path_moves, recursive_path_checksum);
+    double iterative_path = RunMoves<false>(path, path_moves, iterative_path_checksum);
+    std::cout << "path of " << path_length << " nodes, " << path_moves_number << " moves: recursive "
+              << recursive_path << " s, iterative " << iterative_path << " s\n";
+
+    if (recursive_checksum != iterative_checksum || recursive_path_checksum != iterative_path_checksum) {
+        std::cout << "results differ\n";
+        return 1;
+    }
+    return 0;
+}